@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include "ambient_model.h"
+
+// Microbenchmark e relatório de precisão dos backends de ativação (mlp_sigmoid/mlp_tanh)
+// contra a libm, e quantas decisões de modo do ambient_model mudam em todo o cubo RGB
+// ao trocar o backend. "margem maxima" é a maior distância, na saída da libm, entre um
+// limiar da regra e uma decisão que mudou: abaixo do erro do backend, a mudança é só
+// arredondamento na fronteira. Os tempos são do host e servem só para comparação relativa.
+// Uso: host/activation_bench
+
+#define ITERATIONS 20000000
+
+static const char *backend_names[] = {"libm", "pwl", "lut"};
+
+// Distância da saída mais próxima a um dos limiares (0,95 e 0,05) da regra de modo
+static float threshold_margin(const float *o) {
+    float margin = 1.0f;
+    for (int i = 0; i < AMBIENT_OUTPUT_LEN; i++) {
+        float d = fminf(fabsf(o[i] - 0.95f), fabsf(o[i] - 0.05f));
+        if (d < margin) margin = d;
+    }
+    return margin;
+}
+
+// Mesma regra de get_ambient_mode() (sem a verificação de lux)
+static int mode_of(const float *o) {
+    for (int i = 0; i < AMBIENT_OUTPUT_LEN; i++) {
+        if (o[i] < 0.95f) continue;
+        int others_are_zero = 1;
+        for (int j = 0; j < AMBIENT_OUTPUT_LEN; j++) {
+            if (j != i && o[j] > 0.05f) others_are_zero = 0;
+        }
+        if (others_are_zero) return i;
+    }
+    return 3;
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(void) {
+    static unsigned char reference_mode[256][256][256];
+    MLPConst m = ambient_model;
+    float hidden[AMBIENT_HIDDEN_LEN], out[AMBIENT_OUTPUT_LEN];
+
+    m.activation = MLP_ACTIVATION_LIBM;
+    for (int r = 0; r < 256; r++)
+        for (int g = 0; g < 256; g++)
+            for (int b = 0; b < 256; b++) {
+                float X[AMBIENT_INPUT_LEN] = {r / 255.0f, g / 255.0f, b / 255.0f};
+                forward_const(&m, X, hidden, out);
+                reference_mode[r][g][b] = (unsigned char)mode_of(out);
+            }
+
+    printf("%-5s %12s %12s %12s %12s %12s %16s %14s\n", "", "err sigmoid", "err tanh", "ns sigmoid", "ns tanh",
+           "ns forward", "modos alterados", "margem maxima");
+
+    for (int a = MLP_ACTIVATION_LIBM; a <= MLP_ACTIVATION_LUT; a++) {
+        float err_sigmoid = 0, err_tanh = 0;
+        for (int i = -160000; i <= 160000; i++) {
+            float z = i / 10000.0f;
+            float e = fabsf(mlp_sigmoid(a, z) - sigmoid(z));
+            if (e > err_sigmoid) err_sigmoid = e;
+            e = fabsf(mlp_tanh(a, z) - tanhyper(z));
+            if (e > err_tanh) err_tanh = e;
+        }
+
+        volatile float sink = 0;
+        double t0 = now_ns();
+        for (int i = 0; i < ITERATIONS; i++) sink += mlp_sigmoid(a, (i & 4095) / 256.0f - 8.0f);
+        double t1 = now_ns();
+        for (int i = 0; i < ITERATIONS; i++) sink += mlp_tanh(a, (i & 4095) / 512.0f - 4.0f);
+        double t2 = now_ns();
+
+        // Só o forward, sem a comparação de modos, para todos os backends pagarem o mesmo laço
+        m.activation = a;
+        unsigned long inferences = 0;
+        double t3 = now_ns();
+        for (int r = 0; r < 256; r++)
+            for (int g = 0; g < 256; g++)
+                for (int b = 0; b < 256; b++) {
+                    float X[AMBIENT_INPUT_LEN] = {r / 255.0f, g / 255.0f, b / 255.0f};
+                    forward_const(&m, X, hidden, out);
+                    sink += out[0];
+                    inferences++;
+                }
+        double t4 = now_ns();
+
+        // Segunda passada, fora da medição: decisões que mudaram e sua margem na saída da libm
+        unsigned long changed = 0;
+        float max_margin = 0;
+        for (int r = 0; r < 256; r++)
+            for (int g = 0; g < 256; g++)
+                for (int b = 0; b < 256; b++) {
+                    float X[AMBIENT_INPUT_LEN] = {r / 255.0f, g / 255.0f, b / 255.0f};
+                    m.activation = a;
+                    forward_const(&m, X, hidden, out);
+                    if (mode_of(out) == reference_mode[r][g][b]) continue;
+                    changed++;
+                    m.activation = MLP_ACTIVATION_LIBM;
+                    forward_const(&m, X, hidden, out);
+                    float margin = threshold_margin(out);
+                    if (margin > max_margin) max_margin = margin;
+                }
+
+        printf("%-5s %12.2e %12.2e %12.2f %12.2f %12.2f %16lu %14.2e\n", backend_names[a], err_sigmoid, err_tanh,
+               (t1 - t0) / ITERATIONS, (t2 - t1) / ITERATIONS, (t4 - t3) / inferences, changed, max_margin);
+    }
+    return 0;
+}
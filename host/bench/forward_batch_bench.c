@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ambient_model.h"
+
+// Amostras por segundo de forward_batch (entrada em estrutura de arrays, em blocos)
+// contra um laço de forward() e de forward_const() sobre as mesmas entradas, conferindo
+// que as saídas são idênticas.
+// Uso: host/forward_batch_bench [amostras] [bloco]
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+    int samples = argc > 1 ? atoi(argv[1]) : 1 << 21;
+    int block = argc > 2 ? atoi(argv[2]) : 256;
+    if (samples < 1 || block < 1) {
+        fprintf(stderr, "uso: %s [amostras] [bloco]\n", argv[0]);
+        return 2;
+    }
+
+    // Entradas em estrutura de arrays: [AMBIENT_INPUT_LEN][samples]
+    float *X = malloc(sizeof(float) * AMBIENT_INPUT_LEN * samples);
+    float *expected = malloc(sizeof(float) * AMBIENT_OUTPUT_LEN * samples);
+    float *out = malloc(sizeof(float) * AMBIENT_OUTPUT_LEN * samples);
+    float *hidden = malloc(sizeof(float) * AMBIENT_HIDDEN_LEN * block);
+    float *out_block = malloc(sizeof(float) * AMBIENT_OUTPUT_LEN * block);
+    srand(1);
+    for (int i = 0; i < AMBIENT_INPUT_LEN * samples; i++) X[i] = (rand() % 256) / 255.0f;
+
+    static const char *names[] = {"libm", "pwl", "lut"};
+    float *x_block = malloc(sizeof(float) * AMBIENT_INPUT_LEN * block);
+    int mismatch = 0;
+
+    printf("%d amostras, bloco %d (amostras/s)\n", samples, block);
+    printf("%-5s %14s %14s %14s\n", "", "forward", "forward_const", "forward_batch");
+
+    for (int a = MLP_ACTIVATION_LIBM; a <= MLP_ACTIVATION_LUT; a++) {
+        MLPConst m = ambient_model;
+        m.activation = a;
+
+        MLP mlp;
+        model(&mlp, AMBIENT_INPUT_LEN, AMBIENT_HIDDEN_LEN, AMBIENT_OUTPUT_LEN, a, 0, 0, 0);
+        import_weights(&mlp, m.weights);
+
+        double t0 = now_s();
+        for (int s = 0; s < samples; s++) {
+            float x[AMBIENT_INPUT_LEN];
+            for (int j = 0; j < AMBIENT_INPUT_LEN; j++) x[j] = X[j * samples + s];
+            forward(&mlp, x);
+            for (int k = 0; k < AMBIENT_OUTPUT_LEN; k++) expected[k * samples + s] = mlp.output_layer_outputs[k];
+        }
+        double t1 = now_s();
+
+        for (int s = 0; s < samples; s++) {
+            float x[AMBIENT_INPUT_LEN], h[AMBIENT_HIDDEN_LEN], o[AMBIENT_OUTPUT_LEN];
+            for (int j = 0; j < AMBIENT_INPUT_LEN; j++) x[j] = X[j * samples + s];
+            forward_const(&m, x, h, o);
+            for (int k = 0; k < AMBIENT_OUTPUT_LEN; k++) out[k * samples + s] = o[k];
+        }
+        double t2 = now_s();
+        int const_mismatch = memcmp(out, expected, sizeof(float) * AMBIENT_OUTPUT_LEN * samples) != 0;
+
+        // Em blocos: X de cada bloco é copiado para um buffer contíguo [AMBIENT_INPUT_LEN][n]
+        for (int start = 0; start < samples; start += block) {
+            int n = samples - start < block ? samples - start : block;
+            for (int j = 0; j < AMBIENT_INPUT_LEN; j++) memcpy(x_block + j * n, X + j * samples + start, sizeof(float) * n);
+            forward_batch(&m, x_block, hidden, out_block, n);
+            for (int k = 0; k < AMBIENT_OUTPUT_LEN; k++) memcpy(out + k * samples + start, out_block + k * n, sizeof(float) * n);
+        }
+        double t3 = now_s();
+        int batch_mismatch = memcmp(out, expected, sizeof(float) * AMBIENT_OUTPUT_LEN * samples) != 0;
+
+        printf("%-5s %14.0f %14.0f %14.0f%s\n", names[a], samples / (t1 - t0), samples / (t2 - t1),
+               samples / (t3 - t2), (const_mismatch || batch_mismatch) ? "  (SAIDAS DIFERENTES)" : "");
+        mismatch |= const_mismatch || batch_mismatch;
+    }
+    return mismatch;
+}
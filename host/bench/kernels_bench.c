@@ -0,0 +1,267 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include "color_utils.h"
+#include "ambient_model.h"
+#include "ssd1306.h"
+#include "ws2812.h"
+#include "config.h"
+
+// Suíte de microbenchmarks dos kernels de cor, MLP e renderização. Para cada kernel:
+// aquecimento, calibração do número de iterações para que uma repetição dure ~20 ms e
+// várias repetições; reporta a mediana e o mínimo em ns/op e as ops/s da mediana.
+// Com --json o resultado também sai em JSON, para comparar entre mudanças:
+//     host/kernels_bench --json antes.json
+// Uso: host/kernels_bench [--reps N] [--filter texto] [--json arquivo|-]
+// Os tempos são do host e servem para comparação relativa, não como tempos do RP2040.
+
+#define MIN_REP_NS 20e6
+#define MAX_REPS 31
+#define BACKPROP_SAMPLES 64
+
+typedef struct {
+    const char *name;
+    void (*run)(uint32_t i); // Uma operação; i varia a entrada
+} kernel_t;
+
+typedef struct {
+    const char *name;
+    uint64_t iterations;
+    int repetitions;
+    double ns_median, ns_min;
+} result_t;
+
+static volatile uint32_t sink;
+static volatile float sink_f;
+
+static MLP mlp;
+static float *train_X[BACKPROP_SAMPLES], *train_Y[BACKPROP_SAMPLES];
+static ssd1306_t disp;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Entradas pseudoaleatórias baratas, para o custo do gerador não dominar os kernels
+static inline uint32_t mix(uint32_t i) {
+    return i * 2654435761u;
+}
+
+static void run_map(uint32_t i) {
+    sink += map(i & 4095, 0, SENSOR_COLOR_MAX_VALUE, 0, 255);
+}
+
+static void run_rgb_to_hsv(uint32_t i) {
+    uint32_t x = mix(i);
+    float h, s, v;
+    RGBtoHSV(x & 0xFF, (x >> 8) & 0xFF, (x >> 16) & 0xFF, &h, &s, &v); // Contrato 0..255
+    sink_f += h + s + v;
+}
+
+static void run_rgb_to_hsv_fixed(uint32_t i) {
+    uint32_t x = mix(i);
+    CorHSV hsv;
+    RGBtoHSV_fixed(x, x >> 8, x >> 16, &hsv);
+    sink += hsv.h + hsv.v;
+}
+
+static void run_identificar_cor_hsv(uint32_t i) {
+    uint32_t x = mix(i);
+    sink += identificar_cor_hsv((x % 360), ((x >> 9) & 0xFF) / 255.0f, ((x >> 17) & 0xFF) / 255.0f);
+}
+
+static void run_identificar_cor_hsv_fixed(uint32_t i) {
+    uint32_t x = mix(i);
+    CorHSV hsv = {(uint16_t)(x % (360 << HSV_H_FRAC_BITS)), 0, (uint8_t)(x >> 17), (uint8_t)(x >> 9), 0};
+    if (hsv.c > hsv.v) hsv.c = hsv.v;
+    sink += identificar_cor_hsv_fixed(&hsv, &limiares_cor_padrao);
+}
+
+static void run_forward(uint32_t i) {
+    uint32_t x = mix(i);
+    float X[AMBIENT_INPUT_LEN] = {(x & 0xFF) / 255.0f, ((x >> 8) & 0xFF) / 255.0f, ((x >> 16) & 0xFF) / 255.0f};
+    forward(&mlp, X);
+    sink_f += mlp.output_layer_outputs[0];
+}
+
+static void run_forward_const(uint32_t i) {
+    uint32_t x = mix(i);
+    float X[AMBIENT_INPUT_LEN] = {(x & 0xFF) / 255.0f, ((x >> 8) & 0xFF) / 255.0f, ((x >> 16) & 0xFF) / 255.0f};
+    float hidden[AMBIENT_HIDDEN_LEN], out[AMBIENT_OUTPUT_LEN];
+    forward_const(&ambient_model, X, hidden, out);
+    sink_f += out[0];
+}
+
+static void run_forward_q8(uint32_t i) {
+    uint32_t x = mix(i);
+    int16_t X[AMBIENT_INPUT_LEN] = {MLP_Q15_FROM_U8(x & 0xFF), MLP_Q15_FROM_U8((x >> 8) & 0xFF),
+                                    MLP_Q15_FROM_U8((x >> 16) & 0xFF)};
+    int16_t hidden[AMBIENT_HIDDEN_LEN], out[AMBIENT_OUTPUT_LEN];
+    forward_q8(&ambient_model_q8, X, hidden, out);
+    sink += out[0];
+}
+
+// backpropagation imprime o erro médio a cada época; a saída vai para /dev/null durante a
+// medição, mas o custo do printf continua na conta, como no firmware
+static void run_backpropagation_epoch(uint32_t i) {
+    (void)i;
+    backpropagation(&mlp, train_X, train_Y, BACKPROP_SAMPLES);
+    sink_f += mlp.output_layer_weights[0][0];
+}
+
+static void run_ssd1306_fill(uint32_t i) {
+    ssd1306_fill(&disp, i & 1);
+}
+
+static void run_ssd1306_draw_string(uint32_t i) {
+    ssd1306_draw_string(&disp, obter_nome_para_cor((CorIdentificada)(i % (MAGENTA + 1))), i & 63, 8 * ((i >> 6) & 7));
+}
+
+static void run_ssd1306_line(uint32_t i) {
+    uint32_t x = mix(i);
+    ssd1306_line(&disp, x & 127, (x >> 7) & 63, (x >> 13) & 127, (x >> 20) & 63, true);
+}
+
+// Empacotamento de um quadro inteiro da matriz (GRB alinhado à esquerda no buffer de trás)
+static void run_ws2812_pack(uint32_t i) {
+    for (uint led = 0; led < LEDS_COUNT; led++) {
+        uint32_t x = mix(i + led);
+        np_set_pixel(led, x, x >> 8, x >> 16);
+    }
+}
+
+static const kernel_t kernels[] = {
+    {"map", run_map},
+    {"RGBtoHSV", run_rgb_to_hsv},
+    {"RGBtoHSV_fixed", run_rgb_to_hsv_fixed},
+    {"identificar_cor_hsv", run_identificar_cor_hsv},
+    {"identificar_cor_hsv_fixed", run_identificar_cor_hsv_fixed},
+    {"forward", run_forward},
+    {"forward_const", run_forward_const},
+    {"forward_q8", run_forward_q8},
+    {"backpropagation_epoch", run_backpropagation_epoch},
+    {"ssd1306_fill", run_ssd1306_fill},
+    {"ssd1306_draw_string", run_ssd1306_draw_string},
+    {"ssd1306_line", run_ssd1306_line},
+    {"ws2812_pack", run_ws2812_pack},
+};
+#define KERNELS_COUNT (sizeof(kernels) / sizeof(kernels[0]))
+
+static void setup(void) {
+    // max_epochs = 1: cada chamada de backpropagation é uma época; o limiar > 0 garante que ela roda
+    model(&mlp, AMBIENT_INPUT_LEN, AMBIENT_HIDDEN_LEN, AMBIENT_OUTPUT_LEN, ambient_model.activation, 1, 0.1f, 1e-12f);
+    import_weights(&mlp, ambient_model.weights);
+
+    // Rótulos do próprio modelo: o custo por época não depende da convergência
+    for (int i = 0; i < BACKPROP_SAMPLES; i++) {
+        uint32_t x = mix(i);
+        float hidden[AMBIENT_HIDDEN_LEN];
+        train_X[i] = malloc(AMBIENT_INPUT_LEN * sizeof(float));
+        train_Y[i] = malloc(AMBIENT_OUTPUT_LEN * sizeof(float));
+        train_X[i][0] = (x & 0xFF) / 255.0f;
+        train_X[i][1] = ((x >> 8) & 0xFF) / 255.0f;
+        train_X[i][2] = ((x >> 16) & 0xFF) / 255.0f;
+        forward_const(&ambient_model, train_X[i], hidden, train_Y[i]);
+    }
+
+    ssd1306_init(&disp, 128, 64, false, ADDRESS_DISPLAY, I2C_PORT_DISPLAY);
+}
+
+static double time_iterations(const kernel_t *k, uint64_t iterations) {
+    double t0 = now_ns();
+    for (uint64_t i = 0; i < iterations; i++) k->run((uint32_t)i);
+    return now_ns() - t0;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static result_t measure(const kernel_t *k, int reps) {
+    result_t r = {k->name, 1, reps, 0, 0};
+    double ns_per_op[MAX_REPS];
+
+    // Aquecimento e calibração: dobra as iterações até uma rodada passar de MIN_REP_NS
+    while (time_iterations(k, r.iterations) < MIN_REP_NS) r.iterations *= 2;
+
+    for (int rep = 0; rep < reps; rep++) {
+        ns_per_op[rep] = time_iterations(k, r.iterations) / r.iterations;
+    }
+    qsort(ns_per_op, reps, sizeof(double), cmp_double);
+    r.ns_median = ns_per_op[reps / 2];
+    r.ns_min = ns_per_op[0];
+    return r;
+}
+
+static void write_json(FILE *out, const result_t *results, int count, int reps) {
+    fprintf(out, "{\n  \"unit\": \"ns/op\",\n  \"repetitions\": %d,\n  \"benchmarks\": [\n", reps);
+    for (int i = 0; i < count; i++) {
+        fprintf(out,
+                "    {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.3f, \"ns_per_op_min\": %.3f, "
+                "\"ops_per_s\": %.1f}%s\n",
+                results[i].name, (unsigned long long)results[i].iterations, results[i].ns_median, results[i].ns_min,
+                1e9 / results[i].ns_median, i + 1 < count ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+}
+
+int main(int argc, char **argv) {
+    const char *json_path = NULL, *filter = NULL;
+    int reps = 7;
+    result_t results[KERNELS_COUNT];
+    int count = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--json") && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (!strcmp(argv[i], "--filter") && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (!strcmp(argv[i], "--reps") && i + 1 < argc) {
+            reps = atoi(argv[++i]);
+            if (reps < 1) reps = 1;
+            if (reps > MAX_REPS) reps = MAX_REPS;
+        } else {
+            fprintf(stderr, "uso: %s [--reps N] [--filter texto] [--json arquivo|-]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    setup();
+
+    // Com --json -, o JSON é a única coisa no stdout e a tabela vai para o stderr
+    FILE *table = (json_path && !strcmp(json_path, "-")) ? stderr : stdout;
+    fprintf(table, "%-28s %12s %12s %14s\n", "kernel", "ns/op", "ns/op min", "ops/s");
+    for (unsigned k = 0; k < KERNELS_COUNT; k++) {
+        if (filter && !strstr(kernels[k].name, filter)) continue;
+
+        fflush(stdout);
+        int saved_stdout = dup(STDOUT_FILENO), devnull = open("/dev/null", O_WRONLY);
+        dup2(devnull, STDOUT_FILENO); // Silencia o "Erro medio" de backpropagation
+        results[count] = measure(&kernels[k], reps);
+        fflush(stdout);
+        dup2(saved_stdout, STDOUT_FILENO);
+        close(saved_stdout);
+        close(devnull);
+
+        fprintf(table, "%-28s %12.2f %12.2f %14.0f\n", results[count].name, results[count].ns_median,
+                results[count].ns_min, 1e9 / results[count].ns_median);
+        count++;
+    }
+
+    if (json_path) {
+        FILE *out = strcmp(json_path, "-") ? fopen(json_path, "w") : stdout;
+        if (!out) {
+            perror(json_path);
+            return 1;
+        }
+        write_json(out, results, count, reps);
+        if (out != stdout) fclose(out);
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "text_format.h"
+#include "color_utils.h"
+
+// Custo da formatação de um quadro do OLED (as sete strings de task_update_display) com
+// sprintf, como era, e com text_format.h. O texto gerado é conferido antes de medir.
+// Os tempos são do host (glibc); no RP2040 a diferença é maior, porque o %.2f do newlib
+// passa pela emulação de ponto flutuante em software.
+// Uso: host/text_format_bench
+
+#define FRAMES 2000000
+
+typedef struct {
+    uint16_t h, s, lux;
+    uint8_t v, r, g, b;
+    CorIdentificada cor;
+} frame_t;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void frame_at(uint32_t i, frame_t *f) {
+    uint32_t x = i * 2654435761u;
+    f->h = x % (360 << HSV_H_FRAC_BITS);
+    f->s = (x >> 7) % (HSV_S_ONE + 1);
+    f->v = x >> 24;
+    f->r = x >> 3;
+    f->g = x >> 11;
+    f->b = x >> 19;
+    f->lux = (x >> 5) % 2000;
+    f->cor = (CorIdentificada)(i % (MAGENTA + 1));
+}
+
+// Soma simples do texto gerado, para o compilador não descartar a formatação
+static unsigned checksum(const char *s) {
+    unsigned sum = 0;
+    while (*s) sum = sum * 31 + (unsigned char)*s++;
+    return sum;
+}
+
+static unsigned frame_sprintf(const frame_t *f) {
+    char buf[128];
+    unsigned sum = 0;
+    sprintf(buf, "Cor: %s", obter_nome_para_cor(f->cor));
+    sum += checksum(buf);
+    sprintf(buf, "H:%3u", (f->h + (1 << (HSV_H_FRAC_BITS - 1))) >> HSV_H_FRAC_BITS);
+    sum += checksum(buf);
+    sprintf(buf, "S:%.2f", (float)f->s / HSV_S_ONE);
+    sum += checksum(buf);
+    sprintf(buf, "V:%.2f", f->v / 255.0f);
+    sum += checksum(buf);
+    sprintf(buf, "R:%u", f->r);
+    sum += checksum(buf);
+    sprintf(buf, "G:%u", f->g);
+    sum += checksum(buf);
+    sprintf(buf, "B:%u", f->b);
+    sum += checksum(buf);
+    sprintf(buf, "Lux:%u", f->lux);
+    sum += checksum(buf);
+    return sum;
+}
+
+static unsigned frame_fmt(const frame_t *f) {
+    char buf[24];
+    unsigned sum = 0;
+    fmt_str(fmt_str(buf, "Cor: "), obter_nome_para_cor(f->cor));
+    sum += checksum(buf);
+    fmt_uint(fmt_str(buf, "H:"), (f->h + (1 << (HSV_H_FRAC_BITS - 1))) >> HSV_H_FRAC_BITS, 3);
+    sum += checksum(buf);
+    fmt_decimal(fmt_str(buf, "S:"), f->s, HSV_S_ONE, 2);
+    sum += checksum(buf);
+    fmt_decimal(fmt_str(buf, "V:"), f->v, 255, 2);
+    sum += checksum(buf);
+    fmt_uint(fmt_str(buf, "R:"), f->r, 0);
+    sum += checksum(buf);
+    fmt_uint(fmt_str(buf, "G:"), f->g, 0);
+    sum += checksum(buf);
+    fmt_uint(fmt_str(buf, "B:"), f->b, 0);
+    sum += checksum(buf);
+    fmt_uint(fmt_str(buf, "Lux:"), f->lux, 0);
+    sum += checksum(buf);
+    return sum;
+}
+
+int main(void) {
+    frame_t f;
+    unsigned mismatches = 0;
+
+    for (uint32_t i = 0; i < 100000; i++) {
+        frame_at(i, &f);
+        if (frame_sprintf(&f) != frame_fmt(&f)) mismatches++;
+    }
+    printf("quadros com texto diferente do sprintf: %u de 100000\n", mismatches);
+
+    volatile unsigned sink = 0;
+    double t0 = now_ns();
+    for (uint32_t i = 0; i < FRAMES; i++) {
+        frame_at(i, &f);
+        sink += frame_sprintf(&f);
+    }
+    double t1 = now_ns();
+    for (uint32_t i = 0; i < FRAMES; i++) {
+        frame_at(i, &f);
+        sink += frame_fmt(&f);
+    }
+    double t2 = now_ns();
+    (void)sink;
+
+    double ns_sprintf = (t1 - t0) / FRAMES, ns_fmt = (t2 - t1) / FRAMES;
+    printf("%-12s %10s\n", "", "ns/quadro");
+    printf("%-12s %10.1f\n", "sprintf", ns_sprintf);
+    printf("%-12s %10.1f\n", "text_format", ns_fmt);
+    printf("aceleracao: %.1fx\n", ns_sprintf / ns_fmt);
+    return 0;
+}
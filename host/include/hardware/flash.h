@@ -0,0 +1,25 @@
+#ifndef SIM_HARDWARE_FLASH_H
+#define SIM_HARDWARE_FLASH_H
+
+// Substituto do hardware/flash.h: a flash QSPI é um array no host, lido diretamente pelo
+// endereço XIP como no RP2040. Apagar e gravar seguem a NOR (apagar leva tudo a 0xFF,
+// gravar só leva bits a 0), exigem alinhamento e avançam o relógio virtual.
+
+#include <stddef.h>
+#include <stdint.h>
+#include "pico/types.h"
+
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+
+#ifndef PICO_FLASH_SIZE_BYTES
+#define PICO_FLASH_SIZE_BYTES (2 * 1024 * 1024)
+#endif
+
+extern uint8_t sim_flash_memory[PICO_FLASH_SIZE_BYTES];
+#define XIP_BASE ((uintptr_t)sim_flash_memory)
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef SIM_HARDWARE_PIO_H
+#define SIM_HARDWARE_PIO_H
+
+#include "pico/types.h"
+
+// FIFO TX simulado: cada palavra enviada é drenada no ritmo do protocolo WS2812
+// (24 bits a 800 kHz) e o quadro é capturado para inspeção pelo simulador.
+
+typedef struct pio_inst {
+    uint index;
+    volatile uint32_t txf[4]; // Destino de DMA; o simulador consome as palavras escritas aqui
+} pio_hw_t;
+
+typedef pio_hw_t *PIO;
+
+extern pio_hw_t pio0_inst;
+extern pio_hw_t pio1_inst;
+
+#define pio0 (&pio0_inst)
+#define pio1 (&pio1_inst)
+
+typedef struct {
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin;
+} pio_program_t;
+
+typedef struct {
+    uint32_t clkdiv;
+} pio_sm_config;
+
+uint pio_add_program(PIO pio, const pio_program_t *program);
+int pio_claim_unused_sm(PIO pio, bool required);
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data);
+bool pio_sm_is_tx_fifo_full(PIO pio, uint sm);
+void pio_sm_put(PIO pio, uint sm, uint32_t data);
+
+static inline uint pio_get_dreq(PIO pio, uint sm, bool is_tx) {
+    return pio->index * 8 + sm + (is_tx ? 0 : 4);
+}
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef SIM_HARDWARE_SYNC_H
+#define SIM_HARDWARE_SYNC_H
+
+// Barreiras e eventos entre núcleos. __wfe dorme até um __sev do outro núcleo ou até o
+// próximo evento agendado no relógio virtual (o equivalente a uma interrupção).
+
+static inline void __dmb(void) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __compiler_memory_barrier(void) {
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
+
+void __wfe(void);
+void __sev(void);
+
+#endif
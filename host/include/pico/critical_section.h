@@ -0,0 +1,23 @@
+#ifndef SIM_PICO_CRITICAL_SECTION_H
+#define SIM_PICO_CRITICAL_SECTION_H
+
+// No simulador só um núcleo executa por vez e os handlers rodam de forma síncrona,
+// então a seção crítica não precisa travar nada.
+
+typedef struct {
+    int unused;
+} critical_section_t;
+
+static inline void critical_section_init(critical_section_t *crit_sec) {
+    (void)crit_sec;
+}
+
+static inline void critical_section_enter_blocking(critical_section_t *crit_sec) {
+    (void)crit_sec;
+}
+
+static inline void critical_section_exit(critical_section_t *crit_sec) {
+    (void)crit_sec;
+}
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef SIM_PICO_FLASH_H
+#define SIM_PICO_FLASH_H
+
+// Substituto do pico/flash.h. No RP2040, flash_safe_execute pausa o outro núcleo e desliga
+// as interrupções enquanto a flash não pode ser lida; no host func roda direto.
+
+#include "pico/types.h"
+
+bool flash_safe_execute_core_init(void);
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms);
+
+#endif
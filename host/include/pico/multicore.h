@@ -0,0 +1,11 @@
+#ifndef SIM_PICO_MULTICORE_H
+#define SIM_PICO_MULTICORE_H
+
+#include "pico/types.h"
+
+// O núcleo 1 roda numa thread do host, intercalado com o núcleo 0 no relógio virtual:
+// um núcleo só cede a vez quando o tempo simulado avança (sleep, leitura do relógio, __wfe).
+
+void multicore_launch_core1(void (*entry)(void));
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef SIM_PICO_PLATFORM_H
+#define SIM_PICO_PLATFORM_H
+
+static inline void tight_loop_contents(void) {}
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef SIM_PICO_STDIO_USB_H
+#define SIM_PICO_STDIO_USB_H
+
+// Substituto do pico/stdio_usb.h: no host a "USB" é o stdout do processo, sempre conectada.
+
+#include <stdbool.h>
+
+bool stdio_usb_connected(void);
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef SIM_PICO_STDLIB_H
+#define SIM_PICO_STDLIB_H
+
+// Substituto do pico/stdlib.h para o build no host (Linux).
+// Expõe apenas o subconjunto do SDK usado pelo firmware, implementado em host/src.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "pico/types.h"
+#include "pico/platform.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+
+bool stdio_init_all(void);
+int putchar_raw(int c); // Sem tradução de \n para \r\n
+int getchar_timeout_us(uint32_t timeout_us); // Só timeout 0: lê o stdin sem bloquear
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef SIM_H
+#define SIM_H
+
+// API de controle do simulador usado pelo build no host.
+// Permite definir a cena vista pelos sensores, limitar o tempo virtual da execução
+// e inspecionar o estado dos periféricos simulados (display, matriz de LEDs, barramentos).
+
+#include <stdio.h>
+#include "pico/types.h"
+
+#define SIM_SSD1306_PAGES 8
+#define SIM_SSD1306_COLUMNS 128
+#define SIM_WS2812_MAX_LEDS 256
+
+// --- Relógio virtual ---
+void sim_time_advance_us(uint64_t us);
+void sim_set_deadline_ms(uint64_t ms);
+
+// --- Cena observada pelos sensores ---
+void sim_set_scene(uint16_t lux, uint8_t r, uint8_t g, uint8_t b);
+void sim_set_scene_sweep(uint32_t period_ms);
+
+// --- Periféricos ---
+void sim_init(void);
+void sim_gpio_press(uint gpio);
+const uint8_t *sim_ssd1306_gddram(void); // [página * SIM_SSD1306_COLUMNS + coluna]
+void sim_ssd1306_dump(FILE *out);
+uint sim_ws2812_frame(uint32_t *grb, uint max_leds);
+
+// Flash: imagem completa (PICO_FLASH_SIZE_BYTES) para persistir entre execuções
+bool sim_flash_load(const char *path);
+bool sim_flash_save(const char *path);
+uint32_t sim_flash_erase_count(uint32_t sector);
+void sim_flash_fail_safe_execute(uint32_t count); // As próximas count chamadas falham sem gravar
+
+// --- Estatísticas ---
+void sim_report(FILE *out);
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef SIM_WS2812_PIO_H
+#define SIM_WS2812_PIO_H
+
+// Equivalente no host ao cabeçalho gerado por pico_generate_pio_header a partir de ws2812.pio.
+// O programa não é executado: o FIFO simulado em host/src/sim_pio.c consome as palavras.
+
+#include "hardware/pio.h"
+#include "hardware/clocks.h"
+
+#define ws2812_T1 3
+#define ws2812_T2 3
+#define ws2812_T3 4
+
+// Apenas ocupa o espaço de instruções; o simulador não decodifica o programa.
+static const uint16_t ws2812_program_instructions[4] = {0};
+
+static const pio_program_t ws2812_program = {
+    .instructions = ws2812_program_instructions,
+    .length = 4,
+    .origin = -1,
+};
+
+void sim_pio_sm_init(PIO pio, uint sm, uint pin, float freq, bool rgbw);
+
+static inline void ws2812_program_init(PIO pio, uint sm, uint offset, uint pin, float freq, bool rgbw) {
+    (void)offset;
+    sim_pio_sm_init(pio, sm, pin, freq, rgbw);
+}
+
+#endif
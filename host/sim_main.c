@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+
+// Executável do build no host: configura o simulador a partir da linha de comando
+// e entra no main() do firmware (renomeado para firmware_main neste target). A
+// execução termina quando o relógio virtual atinge --duration-ms.
+
+int firmware_main(void);
+
+static bool dump_display = false;
+static const char *flash_image = NULL;
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "uso: %s [opções]\n"
+            "  --duration-ms N   tempo virtual de execução (padrão 10000)\n"
+            "  --lux N           iluminância da cena (padrão 300)\n"
+            "  --rgb R,G,B       cor da cena, 0..255 (padrão 255,255,255)\n"
+            "  --sweep-ms N      alterna entre cenas de teste a cada N ms\n"
+            "  --quiet           descarta a saída do firmware em stdout\n"
+            "  --dump-display    imprime o conteúdo final da GDDRAM do SSD1306\n"
+            "  --flash-image F   carrega a flash de F (se existir) e a salva em F ao sair\n",
+            prog);
+}
+
+static void on_exit_report(void) {
+    fflush(stdout);
+    if (dump_display) sim_ssd1306_dump(stderr);
+    if (flash_image && !sim_flash_save(flash_image)) perror(flash_image);
+    sim_report(stderr);
+}
+
+int main(int argc, char **argv) {
+    unsigned long duration_ms = 10000, sweep_ms = 0;
+    unsigned lux = 300, r = 255, g = 255, b = 255;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (!strcmp(arg, "--duration-ms") && val) {
+            duration_ms = strtoul(argv[++i], NULL, 10);
+        } else if (!strcmp(arg, "--lux") && val) {
+            lux = (unsigned)strtoul(argv[++i], NULL, 10);
+        } else if (!strcmp(arg, "--rgb") && val && sscanf(val, "%u,%u,%u", &r, &g, &b) == 3) {
+            i++;
+        } else if (!strcmp(arg, "--sweep-ms") && val) {
+            sweep_ms = strtoul(argv[++i], NULL, 10);
+        } else if (!strcmp(arg, "--quiet")) {
+            if (!freopen("/dev/null", "w", stdout)) return 1;
+        } else if (!strcmp(arg, "--dump-display")) {
+            dump_display = true;
+        } else if (!strcmp(arg, "--flash-image") && val) {
+            flash_image = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    sim_init();
+    if (flash_image) sim_flash_load(flash_image);
+    sim_set_scene((uint16_t)lux, (uint8_t)r, (uint8_t)g, (uint8_t)b);
+    if (sweep_ms) sim_set_scene_sweep((uint32_t)sweep_ms);
+    sim_set_deadline_ms(duration_ms);
+    atexit(on_exit_report);
+    return firmware_main();
+}
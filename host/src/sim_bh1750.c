@@ -0,0 +1,108 @@
+#include <string.h>
+#include "sim.h"
+#include "sim_internal.h"
+
+// Modelo do BH1750 (GY-302). Cada instrução de modo reinicia a conversão; no modo
+// contínuo o registrador de dados é atualizado a cada período de medição, e uma
+// leitura antes da primeira conversão concluída devolve o valor anterior.
+
+#define BH1750_ADDR 0x23
+
+#define OP_POWER_DOWN 0x00
+#define OP_POWER_ON 0x01
+#define OP_RESET 0x07
+
+#define HRES_US 120000
+#define LRES_US 16000
+
+typedef struct {
+    sim_i2c_device_t dev;
+    bool powered;
+    uint8_t mode;
+    uint64_t mode_since_us;
+    uint64_t conversions;
+    uint16_t data;
+    uint64_t stale_reads;
+} sim_bh1750_t;
+
+static sim_bh1750_t bh1750;
+
+static bool is_measurement(uint8_t op) {
+    switch (op) {
+        case 0x10: case 0x11: case 0x13:
+        case 0x20: case 0x21: case 0x23:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static uint64_t measurement_us(uint8_t mode) {
+    return ((mode & 0x03) == 0x03) ? LRES_US : HRES_US;
+}
+
+static void convert(sim_bh1750_t *s) {
+    if (!s->powered || !is_measurement(s->mode)) return;
+
+    uint64_t elapsed = sim_time_now_us() - s->mode_since_us;
+    uint64_t done = elapsed / measurement_us(s->mode);
+    if (done == 0 || done == s->conversions) {
+        s->stale_reads++;
+        return;
+    }
+    s->conversions = done;
+
+    // Modo H-res2 tem o dobro de resolução (0,5 lux), logo o dobro de contagens
+    uint32_t factor = ((s->mode & 0x03) == 0x01) ? 24 : 12;
+    uint32_t raw = (uint32_t)sim_scene_now().lux * factor / 10;
+    s->data = raw > 65535 ? 65535 : (uint16_t)raw;
+
+    if (s->mode & 0x20) {
+        s->powered = false; // Modos de medida única desligam o sensor ao final
+    }
+}
+
+static void bh1750_write(sim_i2c_device_t *dev, const uint8_t *src, size_t len) {
+    sim_bh1750_t *s = (sim_bh1750_t *)dev;
+    for (size_t i = 0; i < len; i++) {
+        uint8_t op = src[i];
+        if (op == OP_POWER_DOWN) {
+            s->powered = false;
+        } else if (op == OP_POWER_ON) {
+            s->powered = true;
+        } else if (op == OP_RESET) {
+            if (s->powered) s->data = 0;
+        } else if (is_measurement(op)) {
+            convert(s);
+            s->powered = true;
+            s->mode = op;
+            s->mode_since_us = sim_time_now_us();
+            s->conversions = 0;
+        }
+    }
+}
+
+static void bh1750_read(sim_i2c_device_t *dev, uint8_t *dst, size_t len) {
+    sim_bh1750_t *s = (sim_bh1750_t *)dev;
+    convert(s);
+    for (size_t i = 0; i < len; i++) {
+        dst[i] = (i % 2 == 0) ? (s->data >> 8) : (s->data & 0xFF);
+    }
+}
+
+static void bh1750_report(sim_i2c_device_t *dev, FILE *out) {
+    sim_bh1750_t *s = (sim_bh1750_t *)dev;
+    fprintf(out, "           modo=0x%02X, %llu leituras sem conversao nova\n", s->mode,
+            (unsigned long long)s->stale_reads);
+}
+
+void sim_bh1750_attach(uint bus) {
+    memset(&bh1750, 0, sizeof(bh1750));
+    bh1750.dev.name = "bh1750";
+    bh1750.dev.bus = bus;
+    bh1750.dev.address = BH1750_ADDR;
+    bh1750.dev.write = bh1750_write;
+    bh1750.dev.read = bh1750_read;
+    bh1750.dev.report = bh1750_report;
+    sim_i2c_attach(&bh1750.dev);
+}
@@ -0,0 +1,155 @@
+#include <stdlib.h>
+#include <string.h>
+#include "hardware/dma.h"
+#include "hardware/i2c.h"
+#include "hardware/pio.h"
+#include "sim.h"
+#include "sim_internal.h"
+
+// Canais DMA simulados. Uma transferência para o data_cmd de um bloco I2C é
+// convertida em transações (separadas pelo bit STOP) no barramento simulado; o
+// canal termina quando os últimos bytes cabem no FIFO TX, como no hardware. Para o
+// FIFO TX de uma máquina PIO, as palavras seguem o ritmo do protocolo WS2812.
+
+#define SIM_I2C_TX_FIFO_DEPTH 16
+
+typedef struct {
+    bool claimed;
+    dma_channel_config config;
+    volatile void *write_addr;
+    const volatile void *read_addr;
+    uint32_t count;
+    uint64_t busy_until_us;
+    bool irq0_enabled;
+    bool irq0_status;
+    uint64_t transfers;
+} sim_dma_channel_t;
+
+static sim_dma_channel_t channels[NUM_DMA_CHANNELS];
+
+static uint32_t read_word(const sim_dma_channel_t *ch, uint32_t i) {
+    uint32_t idx = ch->config.read_increment ? i : 0;
+    switch (ch->config.size) {
+        case DMA_SIZE_8: return ((const volatile uint8_t *)ch->read_addr)[idx];
+        case DMA_SIZE_16: return ((const volatile uint16_t *)ch->read_addr)[idx];
+        default: return ((const volatile uint32_t *)ch->read_addr)[idx];
+    }
+}
+
+static void complete(void *arg) {
+    sim_dma_channel_t *ch = arg;
+    if (ch->irq0_enabled) {
+        ch->irq0_status = true;
+        sim_irq_raise(DMA_IRQ_0);
+    }
+}
+
+// Entrega os bytes ao barramento I2C e devolve o instante em que o canal termina.
+static uint64_t run_i2c(sim_dma_channel_t *ch, uint bus) {
+    uint8_t *bytes = malloc(ch->count ? ch->count : 1);
+    size_t len = 0;
+    uint64_t end = sim_time_now_us();
+    uint8_t addr = (uint8_t)(bus ? i2c1 : i2c0)->hw->tar;
+
+    for (uint32_t i = 0; i < ch->count; i++) {
+        uint32_t word = read_word(ch, i);
+        bytes[len++] = word & 0xFF;
+        if (word & I2C_IC_DATA_CMD_STOP_BITS) {
+            end = sim_i2c_submit_async(bus, addr, bytes, len);
+            len = 0;
+        }
+    }
+    if (len) end = sim_i2c_submit_async(bus, addr, bytes, len);
+    free(bytes);
+
+    uint64_t fifo_us = SIM_I2C_TX_FIFO_DEPTH * sim_i2c_byte_us(bus);
+    uint64_t now = sim_time_now_us();
+    return end > now + fifo_us ? end - fifo_us : now;
+}
+
+static uint64_t run_pio(sim_dma_channel_t *ch, PIO pio, uint sm) {
+    uint32_t *words = malloc((ch->count ? ch->count : 1) * sizeof(uint32_t));
+    for (uint32_t i = 0; i < ch->count; i++) words[i] = read_word(ch, i);
+    uint64_t end = sim_pio_submit_async(pio, sm, words, ch->count);
+    free(words);
+    return end;
+}
+
+static void start(sim_dma_channel_t *ch) {
+    uint bus, sm;
+    PIO pio;
+    ch->transfers++;
+    if (sim_i2c_match_data_cmd(ch->write_addr, &bus)) {
+        ch->busy_until_us = run_i2c(ch, bus);
+    } else if (sim_pio_match_txf(ch->write_addr, &pio, &sm)) {
+        ch->busy_until_us = run_pio(ch, pio, sm);
+    } else {
+        uint32_t width = 1u << ch->config.size;
+        for (uint32_t i = 0; i < ch->count; i++) {
+            uint32_t word = read_word(ch, i);
+            uint32_t w = ch->config.write_increment ? i : 0;
+            memcpy((uint8_t *)ch->write_addr + w * width, &word, width);
+        }
+        ch->busy_until_us = sim_time_now_us();
+    }
+    sim_schedule_at(ch->busy_until_us, complete, ch);
+}
+
+int dma_claim_unused_channel(bool required) {
+    for (uint i = 0; i < NUM_DMA_CHANNELS; i++) {
+        if (!channels[i].claimed) {
+            channels[i].claimed = true;
+            return (int)i;
+        }
+    }
+    if (required) abort();
+    return -1;
+}
+
+void dma_channel_unclaim(uint channel) {
+    channels[channel].claimed = false;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    (void)channel;
+    return (dma_channel_config){DMA_SIZE_32, true, false, 0x3f};
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger) {
+    sim_dma_channel_t *ch = &channels[channel];
+    ch->config = *config;
+    ch->write_addr = write_addr;
+    ch->read_addr = read_addr;
+    ch->count = transfer_count;
+    if (trigger) start(ch);
+}
+
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count) {
+    sim_dma_channel_t *ch = &channels[channel];
+    ch->read_addr = read_addr;
+    ch->count = transfer_count;
+    start(ch);
+}
+
+bool dma_channel_is_busy(uint channel) {
+    sim_time_advance_us(1); // Custo de acesso ao registrador, para o polling progredir
+    return channels[channel].busy_until_us > sim_time_now_us();
+}
+
+void dma_channel_wait_for_finish_blocking(uint channel) {
+    uint64_t now = sim_time_now_us();
+    if (channels[channel].busy_until_us > now) sim_time_advance_us(channels[channel].busy_until_us - now);
+}
+
+void dma_channel_set_irq0_enabled(uint channel, bool enabled) {
+    channels[channel].irq0_enabled = enabled;
+}
+
+bool dma_channel_get_irq0_status(uint channel) {
+    return channels[channel].irq0_status;
+}
+
+void dma_channel_acknowledge_irq0(uint channel) {
+    channels[channel].irq0_status = false;
+}
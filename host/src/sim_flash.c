@@ -0,0 +1,96 @@
+#include <stdlib.h>
+#include <string.h>
+#include "hardware/flash.h"
+#include "pico/flash.h"
+#include "sim.h"
+#include "sim_internal.h"
+
+// Flash QSPI simulada. Os tempos são os típicos do W25Q16 da Pico: ~45 ms por setor
+// apagado e ~0,8 ms por página gravada. Conta os apagamentos por setor para o relatório
+// de desgaste.
+
+#define SIM_FLASH_ERASE_US 45000
+#define SIM_FLASH_PROGRAM_US 800
+#define SIM_FLASH_SECTORS (PICO_FLASH_SIZE_BYTES / FLASH_SECTOR_SIZE)
+
+uint8_t sim_flash_memory[PICO_FLASH_SIZE_BYTES];
+
+static uint32_t erase_counts[SIM_FLASH_SECTORS];
+static uint64_t pages_programmed = 0;
+static uint32_t safe_execute_failures = 0; // Próximas chamadas de flash_safe_execute que falham
+
+void sim_flash_init(void) {
+    memset(sim_flash_memory, 0xFF, sizeof(sim_flash_memory));
+    safe_execute_failures = 0;
+}
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+    if (flash_offs % FLASH_SECTOR_SIZE || count % FLASH_SECTOR_SIZE || flash_offs + count > PICO_FLASH_SIZE_BYTES) {
+        fprintf(stderr, "flash_range_erase: intervalo invalido (0x%lx, %zu)\n", (unsigned long)flash_offs, count);
+        abort();
+    }
+    memset(sim_flash_memory + flash_offs, 0xFF, count);
+    for (size_t s = 0; s < count / FLASH_SECTOR_SIZE; s++) erase_counts[flash_offs / FLASH_SECTOR_SIZE + s]++;
+    sim_time_advance_us(SIM_FLASH_ERASE_US * (count / FLASH_SECTOR_SIZE));
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count) {
+    if (flash_offs % FLASH_PAGE_SIZE || count % FLASH_PAGE_SIZE || flash_offs + count > PICO_FLASH_SIZE_BYTES) {
+        fprintf(stderr, "flash_range_program: intervalo invalido (0x%lx, %zu)\n", (unsigned long)flash_offs, count);
+        abort();
+    }
+    for (size_t i = 0; i < count; i++) sim_flash_memory[flash_offs + i] &= data[i]; // NOR: só 1 -> 0
+    pages_programmed += count / FLASH_PAGE_SIZE;
+    sim_time_advance_us(SIM_FLASH_PROGRAM_US * (count / FLASH_PAGE_SIZE));
+}
+
+bool flash_safe_execute_core_init(void) {
+    return true;
+}
+
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms) {
+    (void)enter_exit_timeout_ms;
+    if (safe_execute_failures) {
+        safe_execute_failures--;
+        return PICO_ERROR_TIMEOUT; // Como quando o outro núcleo não pausa a tempo: func não roda
+    }
+    func(param);
+    return PICO_OK;
+}
+
+void sim_flash_fail_safe_execute(uint32_t count) {
+    safe_execute_failures = count;
+}
+
+bool sim_flash_load(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return false;
+    size_t n = fread(sim_flash_memory, 1, sizeof(sim_flash_memory), f);
+    fclose(f);
+    return n == sizeof(sim_flash_memory);
+}
+
+bool sim_flash_save(const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f) return false;
+    size_t n = fwrite(sim_flash_memory, 1, sizeof(sim_flash_memory), f);
+    return fclose(f) == 0 && n == sizeof(sim_flash_memory);
+}
+
+uint32_t sim_flash_erase_count(uint32_t sector) {
+    return erase_counts[sector];
+}
+
+void sim_flash_report(FILE *out) {
+    uint64_t erases = 0;
+    uint32_t max_erases = 0, sectors = 0;
+    for (uint32_t s = 0; s < SIM_FLASH_SECTORS; s++) {
+        erases += erase_counts[s];
+        if (erase_counts[s]) sectors++;
+        if (erase_counts[s] > max_erases) max_erases = erase_counts[s];
+    }
+    if (!erases && !pages_programmed) return;
+    fprintf(out, "flash: %llu setores apagados (%lu setores distintos, maximo %lu por setor), %llu paginas gravadas\n",
+            (unsigned long long)erases, (unsigned long)sectors, (unsigned long)max_erases,
+            (unsigned long long)pages_programmed);
+}
@@ -0,0 +1,120 @@
+#include <poll.h>
+#include <unistd.h>
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+#include "hardware/gpio.h"
+#include "hardware/pwm.h"
+#include "hardware/clocks.h"
+#include "sim.h"
+#include "sim_internal.h"
+
+// GPIO, PWM e clocks simulados: guardam estado suficiente para o firmware rodar
+// e para o simulador injetar eventos de botão.
+
+#define SIM_GPIO_COUNT 30
+
+static bool levels[SIM_GPIO_COUNT];
+static uint16_t pwm_levels[SIM_GPIO_COUNT];
+static uint64_t pwm_on_since[SIM_GPIO_COUNT];
+static uint64_t pwm_on_us[SIM_GPIO_COUNT];   // Tempo total com nível PWM != 0
+static uint32_t pwm_pulses[SIM_GPIO_COUNT];  // Transições de 0 para != 0
+static uint32_t irq_masks[SIM_GPIO_COUNT];
+static gpio_irq_callback_t irq_callback = NULL;
+
+bool stdio_init_all(void) {
+    return true;
+}
+
+bool stdio_usb_connected(void) {
+    return true;
+}
+
+int putchar_raw(int c) {
+    return putchar(c);
+}
+
+int getchar_timeout_us(uint32_t timeout_us) {
+    struct pollfd fd = {.fd = STDIN_FILENO, .events = POLLIN};
+    unsigned char c;
+
+    (void)timeout_us;
+    if (poll(&fd, 1, 0) != 1 || read(STDIN_FILENO, &c, 1) != 1) return PICO_ERROR_TIMEOUT;
+    return c;
+}
+
+void gpio_init(uint gpio) {
+    levels[gpio] = false;
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+    (void)gpio;
+    (void)out;
+}
+
+void gpio_put(uint gpio, bool value) {
+    levels[gpio] = value;
+}
+
+bool gpio_get(uint gpio) {
+    return levels[gpio];
+}
+
+void gpio_pull_up(uint gpio) {
+    levels[gpio] = true;
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn) {
+    (void)gpio;
+    (void)fn;
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled, gpio_irq_callback_t callback) {
+    irq_masks[gpio] = enabled ? event_mask : 0;
+    irq_callback = callback;
+}
+
+void sim_gpio_press(uint gpio) {
+    if (irq_callback && (irq_masks[gpio] & GPIO_IRQ_EDGE_FALL)) {
+        irq_callback(gpio, GPIO_IRQ_EDGE_FALL);
+    }
+}
+
+uint pwm_gpio_to_slice_num(uint gpio) {
+    return (gpio >> 1) & 0x07;
+}
+
+pwm_config pwm_get_default_config(void) {
+    return (pwm_config){1.0f, 0xFFFF};
+}
+
+void pwm_init(uint slice_num, pwm_config *c, bool start) {
+    (void)slice_num;
+    (void)c;
+    (void)start;
+}
+
+void pwm_set_gpio_level(uint gpio, uint16_t level) {
+    uint64_t now = sim_time_now_us();
+    if (!pwm_levels[gpio] && level) {
+        pwm_pulses[gpio]++;
+        pwm_on_since[gpio] = now;
+    } else if (pwm_levels[gpio] && !level) {
+        pwm_on_us[gpio] += now - pwm_on_since[gpio];
+    }
+    pwm_levels[gpio] = level;
+}
+
+void sim_gpio_report(FILE *out) {
+    for (uint gpio = 0; gpio < SIM_GPIO_COUNT; gpio++) {
+        uint64_t on_us = pwm_on_us[gpio];
+        if (pwm_levels[gpio]) on_us += sim_time_now_us() - pwm_on_since[gpio];
+        if (pwm_pulses[gpio]) {
+            fprintf(out, "pwm gpio %u: %u acionamentos, %llu us ligado\n", gpio, pwm_pulses[gpio],
+                    (unsigned long long)on_us);
+        }
+    }
+}
+
+uint32_t clock_get_hz(enum clock_index clk_index) {
+    return clk_index == clk_ref ? 12000000 : 125000000;
+}
@@ -0,0 +1,138 @@
+#include <string.h>
+#include "sim.h"
+#include "sim_internal.h"
+
+// Modelo do TCS34725 (sensor do módulo GY-33) em nível de registradores.
+//
+// Byte de comando: bit 7 = CMD, bits 6:5 = tipo de transação, bits 4:0 = endereço.
+// Tipo 01 (auto-incremento) percorre registradores consecutivos. Tipo 00 (byte
+// repetido) permanece no par de 16 bits endereçado, alternando entre o byte baixo e
+// o registrador sombra do byte alto, que é como as leituras de 2 bytes existentes funcionam.
+//
+// Os canais são integrados continuamente enquanto PON|AEN estão ativos; cada ciclo
+// dura 2,4 ms e o tempo de integração é (256 - ATIME) ciclos. As contagens são
+// proporcionais à cena, ao ganho e ao número de ciclos, saturando em 1024 por ciclo.
+
+#define GY33_ADDR 0x29
+#define REG_ENABLE 0x00
+#define REG_ATIME 0x01
+#define REG_CONTROL 0x0F
+#define REG_ID 0x12
+#define REG_STATUS 0x13
+#define REG_CDATAL 0x14
+#define REG_COUNT 0x20
+
+#define ENABLE_PON 0x01
+#define ENABLE_AEN 0x02
+#define STATUS_AVALID 0x01
+#define CYCLE_US 2400
+#define COUNTS_DIVISOR 50 // Escala: lux * ganho * ciclos / 50 = contagem de um canal saturado de cor
+
+typedef struct {
+    sim_i2c_device_t dev;
+    uint8_t regs[REG_COUNT];
+    uint8_t addr;
+    uint8_t type;
+    uint64_t aen_since_us;
+    uint64_t conversions;
+} sim_gy33_t;
+
+static sim_gy33_t gy33;
+
+static uint32_t gain_factor(uint8_t control) {
+    static const uint32_t gains[4] = {1, 4, 16, 60};
+    return gains[control & 0x03];
+}
+
+static void put16(uint8_t *dst, uint32_t value) {
+    dst[0] = value & 0xFF;
+    dst[1] = (value >> 8) & 0xFF;
+}
+
+// Atualiza os registradores de dados com a última integração concluída.
+static void integrate(sim_gy33_t *s) {
+    uint8_t enable = s->regs[REG_ENABLE];
+    if ((enable & (ENABLE_PON | ENABLE_AEN)) != (ENABLE_PON | ENABLE_AEN)) return;
+
+    uint32_t cycles = 256 - s->regs[REG_ATIME];
+    uint64_t integration_us = (uint64_t)cycles * CYCLE_US;
+    uint64_t done = (sim_time_now_us() - s->aen_since_us) / integration_us;
+    if (done == 0 || done == s->conversions) return;
+    s->conversions = done;
+
+    sim_scene_t scene = sim_scene_now();
+    uint64_t scale = (uint64_t)scene.lux * gain_factor(s->regs[REG_CONTROL]) * cycles;
+    uint32_t saturation = cycles * 1024 > 65535 ? 65535 : cycles * 1024;
+    uint64_t r = scale * scene.r / (255 * COUNTS_DIVISOR);
+    uint64_t g = scale * scene.g / (255 * COUNTS_DIVISOR);
+    uint64_t b = scale * scene.b / (255 * COUNTS_DIVISOR);
+    uint64_t c = r + g + b;
+
+    put16(&s->regs[REG_CDATAL + 0], c > saturation ? saturation : (uint32_t)c);
+    put16(&s->regs[REG_CDATAL + 2], r > saturation ? saturation : (uint32_t)r);
+    put16(&s->regs[REG_CDATAL + 4], g > saturation ? saturation : (uint32_t)g);
+    put16(&s->regs[REG_CDATAL + 6], b > saturation ? saturation : (uint32_t)b);
+    s->regs[REG_STATUS] |= STATUS_AVALID;
+}
+
+static void advance(sim_gy33_t *s) {
+    if (s->type == 0x01) {
+        s->addr = (s->addr + 1) % REG_COUNT;
+    } else {
+        s->addr ^= 0x01;
+    }
+}
+
+static void gy33_write(sim_i2c_device_t *dev, const uint8_t *src, size_t len) {
+    sim_gy33_t *s = (sim_gy33_t *)dev;
+    if (len == 0) return;
+    if (src[0] & 0x80) {
+        s->addr = src[0] & 0x1F;
+        s->type = (src[0] >> 5) & 0x03;
+        src++;
+        len--;
+    }
+    for (size_t i = 0; i < len; i++) {
+        uint8_t reg = s->addr;
+        if (reg == REG_ENABLE) {
+            bool was_running = (s->regs[REG_ENABLE] & ENABLE_AEN) != 0;
+            if (!was_running && (src[i] & ENABLE_AEN)) {
+                s->aen_since_us = sim_time_now_us();
+                s->conversions = 0;
+                s->regs[REG_STATUS] &= ~STATUS_AVALID;
+            }
+        }
+        if (reg != REG_ID && reg != REG_STATUS && reg < REG_CDATAL) {
+            s->regs[reg] = src[i];
+        }
+        advance(s);
+    }
+}
+
+static void gy33_read(sim_i2c_device_t *dev, uint8_t *dst, size_t len) {
+    sim_gy33_t *s = (sim_gy33_t *)dev;
+    integrate(s);
+    for (size_t i = 0; i < len; i++) {
+        dst[i] = s->regs[s->addr];
+        advance(s);
+    }
+}
+
+static void gy33_report(sim_i2c_device_t *dev, FILE *out) {
+    sim_gy33_t *s = (sim_gy33_t *)dev;
+    fprintf(out, "           ATIME=0x%02X ganho=%ux, %llu integracoes concluidas\n", s->regs[REG_ATIME],
+            gain_factor(s->regs[REG_CONTROL]), (unsigned long long)s->conversions);
+}
+
+void sim_gy33_attach(uint bus) {
+    memset(&gy33, 0, sizeof(gy33));
+    gy33.dev.name = "gy33";
+    gy33.dev.bus = bus;
+    gy33.dev.address = GY33_ADDR;
+    gy33.dev.write = gy33_write;
+    gy33.dev.read = gy33_read;
+    gy33.dev.report = gy33_report;
+    gy33.regs[REG_ATIME] = 0xFF;
+    gy33.regs[REG_ID] = 0x44;
+    sim_i2c_attach(&gy33.dev);
+}
@@ -0,0 +1,147 @@
+#include <string.h>
+#include "hardware/i2c.h"
+#include "sim.h"
+#include "sim_internal.h"
+
+// Barramento I2C simulado: encaminha cada transação ao modelo do dispositivo
+// endereçado e avança o relógio virtual pelo tempo que ela ocuparia no fio
+// (START + endereço + dados, 9 bits por byte, na taxa configurada em i2c_init).
+// Transações disparadas por DMA ocupam o barramento sem bloquear a CPU; uma
+// transação bloqueante posterior espera o barramento ficar livre.
+
+#define SIM_I2C_BUSES 2
+#define SIM_I2C_TX_FIFO_DEPTH 16
+
+static i2c_hw_t i2c_hw[SIM_I2C_BUSES];
+
+i2c_inst_t i2c0_inst = {0, 100 * 1000, &i2c_hw[0]};
+i2c_inst_t i2c1_inst = {1, 100 * 1000, &i2c_hw[1]};
+
+typedef struct {
+    uint64_t transactions;
+    uint64_t bytes;
+    uint64_t bus_time_us;
+    uint64_t nacks;
+} sim_i2c_bus_stats_t;
+
+static sim_i2c_device_t *devices = NULL;
+static sim_i2c_bus_stats_t bus_stats[SIM_I2C_BUSES];
+static uint baudrates[SIM_I2C_BUSES] = {100 * 1000, 100 * 1000};
+static uint64_t busy_until_us[SIM_I2C_BUSES];
+
+void sim_i2c_attach(sim_i2c_device_t *dev) {
+    dev->next = devices;
+    devices = dev;
+}
+
+static sim_i2c_device_t *find_device(uint bus, uint8_t addr) {
+    for (sim_i2c_device_t *dev = devices; dev; dev = dev->next) {
+        if (dev->bus == bus && dev->address == addr) return dev;
+    }
+    return NULL;
+}
+
+// Contabiliza a transação e devolve sua duração no barramento.
+static uint64_t account(uint bus, sim_i2c_device_t *dev, size_t len) {
+    uint64_t bits = (uint64_t)(len + 1) * 9 + 2; // endereço + dados + START/STOP
+    uint64_t us = (bits * 1000000 + baudrates[bus] - 1) / baudrates[bus];
+    sim_i2c_bus_stats_t *stats = &bus_stats[bus];
+
+    stats->transactions++;
+    stats->bytes += len;
+    stats->bus_time_us += us;
+    if (dev) {
+        dev->transactions++;
+        dev->bytes += len;
+        dev->bus_time_us += us;
+    }
+    if (!dev) stats->nacks++;
+    return us;
+}
+
+// Espera o fim de uma transação DMA em andamento e ocupa o barramento pela duração dada.
+static void run_blocking(uint bus, uint64_t us) {
+    uint64_t now = sim_time_now_us();
+    if (busy_until_us[bus] > now) sim_time_advance_us(busy_until_us[bus] - now);
+    sim_time_advance_us(us);
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+    i2c->baudrate = baudrate;
+    baudrates[i2c->index] = baudrate;
+    return baudrate;
+}
+
+uint64_t sim_i2c_byte_us(uint bus) {
+    return (9 * 1000000 + baudrates[bus] - 1) / baudrates[bus];
+}
+
+uint64_t sim_i2c_submit_async(uint bus, uint8_t addr, const uint8_t *src, size_t len) {
+    sim_i2c_device_t *dev = find_device(bus, addr);
+    uint64_t now = sim_time_now_us();
+    uint64_t start = busy_until_us[bus] > now ? busy_until_us[bus] : now;
+    busy_until_us[bus] = start + account(bus, dev, len);
+    if (dev) dev->write(dev, src, len);
+    return busy_until_us[bus];
+}
+
+bool sim_i2c_match_data_cmd(volatile void *addr, uint *bus) {
+    for (uint i = 0; i < SIM_I2C_BUSES; i++) {
+        if (addr == (volatile void *)&i2c_hw[i].data_cmd) {
+            *bus = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c) {
+    i2c_hw_t *hw = &i2c_hw[i2c->index];
+    sim_time_advance_us(1); // Custo de acesso ao registrador, para o polling progredir
+    uint64_t now = sim_time_now_us();
+    uint64_t left = busy_until_us[i2c->index] > now ? busy_until_us[i2c->index] - now : 0;
+    uint64_t queued = (left + sim_i2c_byte_us(i2c->index) - 1) / sim_i2c_byte_us(i2c->index);
+    hw->txflr = queued > SIM_I2C_TX_FIFO_DEPTH ? SIM_I2C_TX_FIFO_DEPTH : (uint32_t)queued;
+    hw->status = (left ? I2C_IC_STATUS_ACTIVITY_BITS : 0) | (hw->txflr ? 0 : I2C_IC_STATUS_TFE_BITS);
+    return hw;
+}
+
+uint i2c_get_dreq(i2c_inst_t *i2c, bool is_tx) {
+    return 32 + 2 * i2c->index + (is_tx ? 0 : 1);
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void)nostop;
+    sim_i2c_device_t *dev = find_device(i2c->index, addr);
+    run_blocking(i2c->index, account(i2c->index, dev, len));
+    if (!dev) return PICO_ERROR_GENERIC;
+    dev->write(dev, src, len);
+    return (int)len;
+}
+
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop) {
+    (void)nostop;
+    sim_i2c_device_t *dev = find_device(i2c->index, addr);
+    run_blocking(i2c->index, account(i2c->index, dev, len));
+    if (!dev) {
+        memset(dst, 0xFF, len);
+        return PICO_ERROR_GENERIC;
+    }
+    dev->read(dev, dst, len);
+    return (int)len;
+}
+
+void sim_i2c_report(FILE *out) {
+    for (uint i = 0; i < SIM_I2C_BUSES; i++) {
+        sim_i2c_bus_stats_t *s = &bus_stats[i];
+        fprintf(out, "i2c%u: %llu transacoes, %llu bytes, %llu us de barramento, %llu NACKs\n", i,
+                (unsigned long long)s->transactions, (unsigned long long)s->bytes,
+                (unsigned long long)s->bus_time_us, (unsigned long long)s->nacks);
+    }
+    for (sim_i2c_device_t *dev = devices; dev; dev = dev->next) {
+        fprintf(out, "  %-8s (i2c%u, 0x%02X): %llu transacoes, %llu bytes, %llu us\n", dev->name,
+                dev->bus, dev->address, (unsigned long long)dev->transactions,
+                (unsigned long long)dev->bytes, (unsigned long long)dev->bus_time_us);
+        if (dev->report) dev->report(dev, out);
+    }
+}
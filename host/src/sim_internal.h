@@ -0,0 +1,60 @@
+#ifndef SIM_INTERNAL_H
+#define SIM_INTERNAL_H
+
+// Interface interna entre o barramento I2C simulado e os modelos de dispositivo.
+
+#include <stddef.h>
+#include <stdio.h>
+#include "pico/types.h"
+
+struct pio_inst;
+
+typedef struct sim_i2c_device {
+    const char *name;
+    uint bus;
+    uint8_t address;
+    void (*write)(struct sim_i2c_device *dev, const uint8_t *src, size_t len);
+    void (*read)(struct sim_i2c_device *dev, uint8_t *dst, size_t len);
+    void (*report)(struct sim_i2c_device *dev, FILE *out);
+    uint64_t transactions;
+    uint64_t bytes;
+    uint64_t bus_time_us;
+    struct sim_i2c_device *next;
+} sim_i2c_device_t;
+
+typedef struct {
+    uint16_t lux;
+    uint8_t r, g, b;
+} sim_scene_t;
+
+// Eventos agendados no relógio virtual (fim de DMA, alarmes), disparados em ordem
+typedef void (*sim_event_fn_t)(void *arg);
+void sim_schedule_at(uint64_t at_us, sim_event_fn_t fn, void *arg);
+void sim_clock_advance_to(uint64_t target_us); // Dispara os eventos até target_us
+uint64_t sim_next_event_us(void);
+
+// Núcleos simulados: cada um roda numa thread, mas só um executa por vez; o que chama
+// sim_core_advance_to cede a vez se o outro tiver de acordar antes (ou no mesmo instante)
+void sim_core_advance_to(uint64_t target_us);
+
+void sim_irq_raise(uint num);
+
+void sim_i2c_attach(sim_i2c_device_t *dev);
+uint64_t sim_i2c_submit_async(uint bus, uint8_t addr, const uint8_t *src, size_t len);
+uint64_t sim_i2c_byte_us(uint bus);
+bool sim_i2c_match_data_cmd(volatile void *addr, uint *bus);
+void sim_i2c_report(FILE *out);
+void sim_pio_report(FILE *out);
+void sim_gpio_report(FILE *out);
+void sim_flash_init(void);
+void sim_flash_report(FILE *out);
+bool sim_pio_match_txf(volatile void *addr, struct pio_inst **pio, uint *sm);
+uint64_t sim_pio_submit_async(struct pio_inst *pio, uint sm, const uint32_t *data, uint32_t count);
+sim_scene_t sim_scene_now(void);
+uint64_t sim_time_now_us(void);
+
+void sim_gy33_attach(uint bus);
+void sim_bh1750_attach(uint bus);
+void sim_ssd1306_attach(uint bus, uint8_t address);
+
+#endif
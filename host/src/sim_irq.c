@@ -0,0 +1,32 @@
+#include "hardware/irq.h"
+#include "sim_internal.h"
+
+#define SIM_MAX_SHARED_HANDLERS 4
+
+static irq_handler_t handlers[SIM_IRQ_COUNT][SIM_MAX_SHARED_HANDLERS];
+static bool enabled[SIM_IRQ_COUNT];
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler) {
+    handlers[num][0] = handler;
+}
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority) {
+    (void)order_priority;
+    for (uint i = 0; i < SIM_MAX_SHARED_HANDLERS; i++) {
+        if (!handlers[num][i] || handlers[num][i] == handler) {
+            handlers[num][i] = handler;
+            return;
+        }
+    }
+}
+
+void irq_set_enabled(uint num, bool enable) {
+    enabled[num] = enable;
+}
+
+void sim_irq_raise(uint num) {
+    if (!enabled[num]) return;
+    for (uint i = 0; i < SIM_MAX_SHARED_HANDLERS && handlers[num][i]; i++) {
+        handlers[num][i]();
+    }
+}
@@ -0,0 +1,115 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include "pico/multicore.h"
+#include "pico/time.h"
+#include "hardware/sync.h"
+#include "sim_internal.h"
+
+// Os dois núcleos são threads, mas a execução é passada de uma para a outra como um
+// bastão: só o núcleo running_core executa. Cada núcleo informa até quando quer avançar
+// (wake_at) e o relógio só anda até o menor desses instantes, então o intercalamento
+// é determinístico e as estruturas do simulador não precisam de trava própria.
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t turn = PTHREAD_COND_INITIALIZER;
+static uint running_core = 0;
+static bool core1_launched = false;
+static uint64_t wake_at[2];
+static bool waiting_event[2]; // Dentro de __wfe
+static bool event_flag[2];    // Registrador de evento: __sev antes do __wfe não se perde
+static void (*core1_entry)(void);
+static __thread uint this_core = 0;
+
+// Passa a vez para o outro núcleo e espera ela voltar
+static void hand_over(uint other) {
+    pthread_mutex_lock(&lock);
+    running_core = other;
+    pthread_cond_broadcast(&turn);
+    while (running_core != this_core) pthread_cond_wait(&turn, &lock);
+    pthread_mutex_unlock(&lock);
+}
+
+void sim_core_advance_to(uint64_t target_us) {
+    uint me = this_core, other = 1 - me;
+
+    if (!core1_launched) {
+        sim_clock_advance_to(target_us);
+        return;
+    }
+
+    wake_at[me] = target_us;
+    if (wake_at[other] <= target_us) {
+        // O outro núcleo acorda antes (ou junto: alterna): o relógio vai até lá e ele
+        // executa. Quem devolver a vez já terá levado o relógio até wake_at[me].
+        sim_clock_advance_to(wake_at[other]);
+        hand_over(other);
+        return;
+    }
+    sim_clock_advance_to(target_us);
+}
+
+static void *core1_thread(void *arg) {
+    (void)arg;
+    this_core = 1;
+    pthread_mutex_lock(&lock);
+    while (running_core != 1) pthread_cond_wait(&turn, &lock);
+    pthread_mutex_unlock(&lock);
+
+    core1_entry();
+
+    // O núcleo 1 terminou: nunca mais pede a vez
+    pthread_mutex_lock(&lock);
+    wake_at[1] = UINT64_MAX;
+    running_core = 0;
+    pthread_cond_broadcast(&turn);
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+void multicore_launch_core1(void (*entry)(void)) {
+    pthread_t thread;
+
+    core1_entry = entry;
+    wake_at[1] = sim_time_now_us();
+    core1_launched = true;
+    if (pthread_create(&thread, NULL, core1_thread, NULL)) abort();
+    pthread_detach(thread);
+}
+
+void __wfe(void) {
+    uint me = this_core;
+
+    if (event_flag[me]) {
+        event_flag[me] = false;
+        return;
+    }
+    waiting_event[me] = true;
+    sim_core_advance_to(sim_next_event_us());
+    waiting_event[me] = false;
+    event_flag[me] = false;
+}
+
+void __sev(void) {
+    uint other = 1 - this_core;
+
+    event_flag[other] = true;
+    if (waiting_event[other]) wake_at[other] = sim_time_now_us();
+}
+
+bool best_effort_wfe_or_timeout(absolute_time_t timeout_timestamp) {
+    uint me = this_core;
+    uint64_t next = sim_next_event_us();
+
+    if (event_flag[me]) {
+        event_flag[me] = false;
+        return sim_time_now_us() >= timeout_timestamp;
+    }
+    // Prazo já vencido: custa o mesmo que uma leitura do relógio, para o laço progredir
+    uint64_t target = next < timeout_timestamp ? next : timeout_timestamp;
+    if (target <= sim_time_now_us()) target = sim_time_now_us() + 1;
+    waiting_event[me] = true;
+    sim_core_advance_to(target);
+    waiting_event[me] = false;
+    event_flag[me] = false;
+    return sim_time_now_us() >= timeout_timestamp;
+}
@@ -0,0 +1,116 @@
+#include <string.h>
+#include "hardware/pio.h"
+#include "sim.h"
+#include "sim_internal.h"
+
+// FIFO TX de uma máquina de estado PIO rodando o programa ws2812. Cada palavra leva
+// 24 bits no ritmo configurado para sair; com o FIFO cheio (8 entradas com o TX
+// unido) pio_sm_put_blocking espera o relógio virtual até abrir espaço. Uma pausa
+// maior que o tempo de reset (50 us) fecha o quadro capturado.
+
+#define SIM_PIO_FIFO_DEPTH 8
+#define SIM_WS2812_RESET_US 50
+
+pio_hw_t pio0_inst = {0, {0}};
+pio_hw_t pio1_inst = {1, {0}};
+
+static uint64_t word_us = 30;
+static uint64_t busy_until_us = 0;
+static uint32_t pending[SIM_WS2812_MAX_LEDS];
+static uint pending_len = 0;
+static uint32_t frame[SIM_WS2812_MAX_LEDS];
+static uint frame_len = 0;
+static uint64_t words = 0;
+static uint64_t frames = 0;
+static uint64_t stall_us = 0;
+static uint claimed_sms = 0;
+
+uint pio_add_program(PIO pio, const pio_program_t *program) {
+    (void)pio;
+    (void)program;
+    return 0;
+}
+
+int pio_claim_unused_sm(PIO pio, bool required) {
+    (void)required;
+    (void)pio;
+    return (int)(claimed_sms++ % 4);
+}
+
+void sim_pio_sm_init(PIO pio, uint sm, uint pin, float freq, bool rgbw) {
+    (void)pio;
+    (void)sm;
+    (void)pin;
+    word_us = (uint64_t)((rgbw ? 32 : 24) * 1000000.0f / freq + 0.5f);
+}
+
+static void latch_if_idle(uint64_t now) {
+    if (pending_len && now >= busy_until_us + SIM_WS2812_RESET_US) {
+        memcpy(frame, pending, pending_len * sizeof(uint32_t));
+        frame_len = pending_len;
+        pending_len = 0;
+        frames++;
+    }
+}
+
+bool pio_sm_is_tx_fifo_full(PIO pio, uint sm) {
+    (void)pio;
+    (void)sm;
+    uint64_t now = sim_time_now_us();
+    return busy_until_us > now + SIM_PIO_FIFO_DEPTH * word_us;
+}
+
+void pio_sm_put(PIO pio, uint sm, uint32_t data) {
+    (void)pio;
+    (void)sm;
+    uint64_t now = sim_time_now_us();
+    latch_if_idle(now);
+    if (busy_until_us < now) busy_until_us = now;
+    busy_until_us += word_us;
+    if (pending_len < SIM_WS2812_MAX_LEDS) pending[pending_len++] = data >> 8;
+    words++;
+}
+
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data) {
+    while (pio_sm_is_tx_fifo_full(pio, sm)) {
+        uint64_t wait = busy_until_us - sim_time_now_us() - SIM_PIO_FIFO_DEPTH * word_us;
+        stall_us += wait;
+        sim_time_advance_us(wait);
+    }
+    pio_sm_put(pio, sm, data);
+}
+
+bool sim_pio_match_txf(volatile void *addr, PIO *pio, uint *sm) {
+    PIO blocks[2] = {pio0, pio1};
+    for (uint i = 0; i < 2; i++) {
+        for (uint j = 0; j < 4; j++) {
+            if (addr == (volatile void *)&blocks[i]->txf[j]) {
+                *pio = blocks[i];
+                *sm = j;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+uint64_t sim_pio_submit_async(PIO pio, uint sm, const uint32_t *data, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) pio_sm_put(pio, sm, data[i]);
+    // O canal termina quando a última palavra entra no FIFO
+    uint64_t fifo_us = SIM_PIO_FIFO_DEPTH * word_us;
+    uint64_t now = sim_time_now_us();
+    return busy_until_us > now + fifo_us ? busy_until_us - fifo_us : now;
+}
+
+uint sim_ws2812_frame(uint32_t *grb, uint max_leds) {
+    latch_if_idle(sim_time_now_us());
+    uint n = frame_len < max_leds ? frame_len : max_leds;
+    memcpy(grb, frame, n * sizeof(uint32_t));
+    return n;
+}
+
+void sim_pio_report(FILE *out) {
+    latch_if_idle(sim_time_now_us());
+    fprintf(out, "ws2812: %llu palavras, %llu quadros, %llu us bloqueado no FIFO\n",
+            (unsigned long long)words, (unsigned long long)frames, (unsigned long long)stall_us);
+}
@@ -0,0 +1,161 @@
+#include <string.h>
+#include "sim.h"
+#include "sim_internal.h"
+
+// Modelo do controlador SSD1306: interpreta bytes de controle (Co, D/C), comandos
+// com argumentos (que podem chegar em transações separadas) e grava os dados na
+// GDDRAM respeitando o modo de endereçamento e a janela de colunas/páginas.
+
+#define CTRL_CO 0x80
+#define CTRL_DC 0x40
+
+typedef struct {
+    sim_i2c_device_t dev;
+    uint8_t gddram[SIM_SSD1306_PAGES * SIM_SSD1306_COLUMNS];
+    uint8_t mem_mode; // 0 = horizontal, 1 = vertical, 2 = página
+    uint8_t col_start, col_end, page_start, page_end;
+    uint8_t col, page;
+    uint8_t cmd;
+    uint8_t args[6];
+    uint8_t nargs, needed;
+    bool display_on;
+    uint64_t data_bytes;
+    uint64_t commands;
+} sim_ssd1306_t;
+
+static sim_ssd1306_t ssd;
+
+static uint8_t args_for(uint8_t cmd) {
+    switch (cmd) {
+        case 0x21: case 0x22: case 0xA3:
+            return 2;
+        case 0x26: case 0x27:
+            return 6;
+        case 0x29: case 0x2A:
+            return 5;
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+        case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static void execute(sim_ssd1306_t *s) {
+    uint8_t cmd = s->cmd;
+    s->commands++;
+    if (cmd == 0x20) {
+        s->mem_mode = s->args[0] & 0x03;
+    } else if (cmd == 0x21) {
+        s->col_start = s->args[0] & 0x7F;
+        s->col_end = s->args[1] & 0x7F;
+        s->col = s->col_start;
+    } else if (cmd == 0x22) {
+        s->page_start = s->args[0] & 0x07;
+        s->page_end = s->args[1] & 0x07;
+        s->page = s->page_start;
+    } else if (cmd == 0xAE || cmd == 0xAF) {
+        s->display_on = cmd & 0x01;
+    } else if (cmd <= 0x0F) {
+        s->col = (s->col & 0xF0) | cmd;
+    } else if (cmd >= 0x10 && cmd <= 0x1F) {
+        s->col = (s->col & 0x0F) | ((cmd & 0x07) << 4);
+    } else if (cmd >= 0xB0 && cmd <= 0xB7) {
+        s->page = cmd & 0x07;
+    }
+}
+
+static void command_byte(sim_ssd1306_t *s, uint8_t byte) {
+    if (s->needed) {
+        s->args[s->nargs++] = byte;
+        if (s->nargs == s->needed) {
+            s->needed = 0;
+            execute(s);
+        }
+        return;
+    }
+    s->cmd = byte;
+    s->nargs = 0;
+    s->needed = args_for(byte);
+    if (!s->needed) execute(s);
+}
+
+static void data_byte(sim_ssd1306_t *s, uint8_t byte) {
+    s->gddram[s->page * SIM_SSD1306_COLUMNS + s->col] = byte;
+    s->data_bytes++;
+
+    if (s->mem_mode == 1) {
+        if (s->page++ >= s->page_end) {
+            s->page = s->page_start;
+            s->col = (s->col >= s->col_end) ? s->col_start : s->col + 1;
+        }
+    } else if (s->mem_mode == 0) {
+        if (s->col++ >= s->col_end) {
+            s->col = s->col_start;
+            s->page = (s->page >= s->page_end) ? s->page_start : s->page + 1;
+        }
+    } else {
+        s->col = (s->col + 1) % SIM_SSD1306_COLUMNS;
+    }
+}
+
+static void ssd1306_write(sim_i2c_device_t *dev, const uint8_t *src, size_t len) {
+    sim_ssd1306_t *s = (sim_ssd1306_t *)dev;
+    size_t i = 0;
+    while (i < len) {
+        uint8_t control = src[i++];
+        bool data = control & CTRL_DC;
+        if (control & CTRL_CO) {
+            // Um único byte segue este controle; depois vem outro byte de controle
+            if (i < len) {
+                data ? data_byte(s, src[i]) : command_byte(s, src[i]);
+                i++;
+            }
+        } else {
+            // Fluxo contínuo até o fim da transação
+            for (; i < len; i++) {
+                data ? data_byte(s, src[i]) : command_byte(s, src[i]);
+            }
+        }
+    }
+}
+
+static void ssd1306_read(sim_i2c_device_t *dev, uint8_t *dst, size_t len) {
+    (void)dev;
+    memset(dst, 0, len); // Status: display ligado, sem leitura de GDDRAM via I2C
+}
+
+static void ssd1306_report(sim_i2c_device_t *dev, FILE *out) {
+    sim_ssd1306_t *s = (sim_ssd1306_t *)dev;
+    fprintf(out, "           %llu comandos, %llu bytes de GDDRAM, display %s\n",
+            (unsigned long long)s->commands, (unsigned long long)s->data_bytes,
+            s->display_on ? "ligado" : "desligado");
+}
+
+const uint8_t *sim_ssd1306_gddram(void) {
+    return ssd.gddram;
+}
+
+void sim_ssd1306_dump(FILE *out) {
+    for (uint y = 0; y < SIM_SSD1306_PAGES * 8; y++) {
+        for (uint x = 0; x < SIM_SSD1306_COLUMNS; x++) {
+            uint8_t byte = ssd.gddram[(y / 8) * SIM_SSD1306_COLUMNS + x];
+            fputc((byte >> (y % 8)) & 0x01 ? '#' : '.', out);
+        }
+        fputc('\n', out);
+    }
+}
+
+void sim_ssd1306_attach(uint bus, uint8_t address) {
+    memset(&ssd, 0, sizeof(ssd));
+    ssd.dev.name = "ssd1306";
+    ssd.dev.bus = bus;
+    ssd.dev.address = address;
+    ssd.dev.write = ssd1306_write;
+    ssd.dev.read = ssd1306_read;
+    ssd.dev.report = ssd1306_report;
+    ssd.mem_mode = 2;
+    ssd.col_end = SIM_SSD1306_COLUMNS - 1;
+    ssd.page_end = SIM_SSD1306_PAGES - 1;
+    sim_i2c_attach(&ssd.dev);
+}
@@ -0,0 +1,155 @@
+#include <stdlib.h>
+#include "pico/time.h"
+#include "sim.h"
+#include "sim_internal.h"
+
+// Custo virtual de cada leitura do relógio. Garante que laços de espera ativa
+// (polling de timestamps) progridam no tempo simulado em vez de travarem.
+#define SIM_CLOCK_READ_COST_US 1
+#define SIM_MAX_EVENTS 64
+#define SIM_MAX_ALARMS 16
+
+typedef struct {
+    uint64_t at_us;
+    sim_event_fn_t fn;
+    void *arg;
+} sim_event_t;
+
+static uint64_t now_us = 0;
+static uint64_t deadline_us = 0;
+static sim_event_t events[SIM_MAX_EVENTS]; // Ordenados pelo instante de disparo
+static uint event_count = 0;
+
+typedef struct {
+    alarm_id_t id; // 0 = livre
+    uint64_t target_us;
+    alarm_callback_t callback;
+    void *user_data;
+} sim_alarm_t;
+
+static sim_alarm_t alarms[SIM_MAX_ALARMS];
+static alarm_id_t next_alarm_id = 1;
+
+void sim_schedule_at(uint64_t at_us, sim_event_fn_t fn, void *arg) {
+    if (event_count == SIM_MAX_EVENTS) abort();
+    uint i = event_count++;
+    while (i > 0 && events[i - 1].at_us > at_us) {
+        events[i] = events[i - 1];
+        i--;
+    }
+    events[i] = (sim_event_t){at_us, fn, arg};
+}
+
+static uint dispatch_depth = 0;
+
+void sim_clock_advance_to(uint64_t target) {
+    if (deadline_us && target > deadline_us) target = deadline_us;
+    if (target < now_us) target = now_us;
+
+    // Dispara os eventos vencidos no instante em que ocorrem; um evento pode agendar outros
+    dispatch_depth++;
+    while (event_count && events[0].at_us <= target) {
+        sim_event_t ev = events[0];
+        for (uint i = 1; i < event_count; i++) events[i - 1] = events[i];
+        event_count--;
+        if (ev.at_us > now_us) now_us = ev.at_us;
+        ev.fn(ev.arg);
+    }
+    dispatch_depth--;
+
+    now_us = target;
+    if (deadline_us && now_us >= deadline_us) {
+        exit(0); // O relatório é emitido pelo handler registrado com atexit()
+    }
+}
+
+uint64_t sim_next_event_us(void) {
+    return event_count ? events[0].at_us : UINT64_MAX;
+}
+
+void sim_time_advance_us(uint64_t us) {
+    // Dentro de um evento (alarme, IRQ) o tempo avança sem trocar de núcleo
+    if (dispatch_depth) {
+        now_us += us;
+        return;
+    }
+    sim_core_advance_to(now_us + us);
+}
+
+void sim_set_deadline_ms(uint64_t ms) {
+    deadline_us = ms * 1000;
+}
+
+uint64_t sim_time_now_us(void) {
+    return now_us;
+}
+
+uint64_t time_us_64(void) {
+    sim_time_advance_us(SIM_CLOCK_READ_COST_US);
+    return now_us;
+}
+
+uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+absolute_time_t get_absolute_time(void) {
+    return time_us_64();
+}
+
+void sleep_us(uint64_t us) {
+    sim_time_advance_us(us);
+}
+
+void sleep_ms(uint32_t ms) {
+    sim_time_advance_us((uint64_t)ms * 1000);
+}
+
+static void fire_alarm(void *arg) {
+    sim_alarm_t *alarm = arg;
+    alarm_id_t id = alarm->id;
+    if (!id || alarm->target_us != now_us) return; // Cancelado (ou substituído)
+
+    int64_t next = alarm->callback(id, alarm->user_data);
+    if (alarm->id != id) return; // Cancelado dentro do callback
+    if (next == 0) {
+        alarm->id = 0;
+        return;
+    }
+    alarm->target_us = next > 0 ? now_us + (uint64_t)next : alarm->target_us + (uint64_t)(-next);
+    if (alarm->target_us <= now_us) alarm->target_us = now_us + 1;
+    sim_schedule_at(alarm->target_us, fire_alarm, alarm);
+}
+
+alarm_id_t add_alarm_at(absolute_time_t time, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    if (time <= now_us) {
+        if (!fire_if_past) return 0;
+        time = now_us;
+    }
+    for (uint i = 0; i < SIM_MAX_ALARMS; i++) {
+        if (!alarms[i].id) {
+            alarms[i] = (sim_alarm_t){next_alarm_id++, time, callback, user_data};
+            sim_schedule_at(time, fire_alarm, &alarms[i]);
+            return alarms[i].id;
+        }
+    }
+    return -1;
+}
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    return add_alarm_at(now_us + us, callback, user_data, fire_if_past);
+}
+
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    return add_alarm_at(now_us + (uint64_t)ms * 1000, callback, user_data, fire_if_past);
+}
+
+bool cancel_alarm(alarm_id_t alarm_id) {
+    for (uint i = 0; i < SIM_MAX_ALARMS; i++) {
+        if (alarm_id > 0 && alarms[i].id == alarm_id) {
+            alarms[i].id = 0;
+            return true;
+        }
+    }
+    return false;
+}
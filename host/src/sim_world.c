@@ -0,0 +1,46 @@
+#include "sim.h"
+#include "hardware/i2c.h"
+#include "sim_internal.h"
+#include "config.h"
+
+// Cena observada pelos sensores e inicialização dos dispositivos simulados nos
+// mesmos barramentos e endereços definidos em config.h.
+
+// Varredura: percorre cores e níveis de luz que exercitam todos os ramos da classificação
+static const sim_scene_t sweep_table[] = {
+    {300, 255, 0, 0},    {500, 255, 255, 0}, {800, 0, 255, 0},   {150, 0, 255, 255},
+    {600, 0, 0, 255},    {900, 255, 0, 255}, {400, 255, 255, 255}, {5, 40, 40, 40},
+};
+
+static sim_scene_t scene = {300, 255, 255, 255};
+static uint32_t sweep_period_ms = 0;
+
+void sim_set_scene(uint16_t lux, uint8_t r, uint8_t g, uint8_t b) {
+    scene = (sim_scene_t){lux, r, g, b};
+    sweep_period_ms = 0;
+}
+
+void sim_set_scene_sweep(uint32_t period_ms) {
+    sweep_period_ms = period_ms;
+}
+
+sim_scene_t sim_scene_now(void) {
+    if (!sweep_period_ms) return scene;
+    uint64_t step = sim_time_now_us() / 1000 / sweep_period_ms;
+    return sweep_table[step % (sizeof(sweep_table) / sizeof(sweep_table[0]))];
+}
+
+void sim_init(void) {
+    sim_gy33_attach(i2c_hw_index(I2C_PORT_SENSORS));
+    sim_bh1750_attach(i2c_hw_index(I2C_PORT_SENSORS));
+    sim_ssd1306_attach(i2c_hw_index(I2C_PORT_DISPLAY), ADDRESS_DISPLAY);
+    sim_flash_init();
+}
+
+void sim_report(FILE *out) {
+    fprintf(out, "tempo virtual: %llu us\n", (unsigned long long)sim_time_now_us());
+    sim_i2c_report(out);
+    sim_pio_report(out);
+    sim_gpio_report(out);
+    sim_flash_report(out);
+}
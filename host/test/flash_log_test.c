@@ -0,0 +1,231 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "flash_log.h"
+#include "telemetry.h"
+#include "config.h"
+#include "hardware/flash.h"
+#include "sim.h"
+
+// Log circular na flash simulada: grava amostras aleatórias até dar várias voltas na região,
+// decodifica o dump e confere que ele é exatamente o final da sequência gravada, em ordem;
+// que o desgaste é uniforme entre os setores; que um "reboot" retoma depois da última
+// página (com a marca de boot), que uma página corrompida é descartada sem afetar as demais e
+// que uma gravação que falha é refeita sem perder a página.
+
+#define SAMPLES 40000
+#define REBOOT_SAMPLES 500
+#define PAGES (FLASH_LOG_SECTORS * (FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE))
+
+static flash_log_entry_t written[SAMPLES + REBOOT_SAMPLES];
+static flash_log_entry_t decoded[SAMPLES + REBOOT_SAMPLES];
+static flash_log_entry_t before[SAMPLES + REBOOT_SAMPLES];
+static uint32_t page_seqs[PAGES + 1];   // Sequência de cada página do último dump
+static size_t page_starts[PAGES + 2];   // Índice em decoded da primeira entrada de cada página
+static unsigned gaps;                   // Saltos de sequência entre páginas do último dump
+static uint8_t dump[1 << 19];
+static size_t dump_len;
+static unsigned long errors = 0;
+
+static void check(bool ok, const char *what) {
+    if (!ok && errors++ < 10) printf("falha: %s\n", what);
+}
+
+static int capture(int c) {
+    if (dump_len < sizeof(dump)) dump[dump_len++] = (uint8_t)c;
+    return c;
+}
+
+static sample_record_t random_sample(uint32_t i, flash_log_entry_t *e) {
+    static uint16_t raw[SENSOR_CHANNELS];
+    sample_record_t s;
+
+    memset(&s, 0, sizeof(s));
+    for (int ch = 0; ch < SENSOR_CHANNELS; ch++) {
+        raw[ch] = (rand() % 50 == 0) ? (uint16_t)rand() : (uint16_t)(raw[ch] + rand() % 41 - 20); // Passeio com saltos
+    }
+    s.timestamp_ms = i * 103 + rand() % 3;
+    s.raw_lux = raw[SENSOR_LUX];
+    s.raw_r = raw[SENSOR_RED];
+    s.raw_g = raw[SENSOR_GREEN];
+    s.raw_b = raw[SENSOR_BLUE];
+    s.raw_c = raw[SENSOR_CLEAR];
+    s.cor = (CorIdentificada)(rand() % (MAGENTA + 1));
+    s.mode = rand() % 4;
+    s.alert = rand() & 1;
+
+    e->timestamp_ms = s.timestamp_ms;
+    memcpy(e->raw, raw, sizeof(raw));
+    e->cor = s.cor;
+    e->mode = s.mode;
+    e->alert = s.alert;
+    return s;
+}
+
+// Decodifica o dump capturado; retorna o número de entradas e conta os saltos de sequência
+static size_t decode_dump(uint32_t *pages) {
+    static uint8_t frame[COBS_MAX_ENCODED_LEN(FLASH_PAGE_SIZE)];
+    uint8_t page[FLASH_PAGE_SIZE];
+    size_t n = 0, len = 0;
+    uint32_t last_seq = 0;
+
+    *pages = 0;
+    gaps = 0;
+    for (size_t i = 0; i < dump_len; i++) {
+        if (dump[i]) {
+            if (len < sizeof(frame)) frame[len++] = dump[i];
+            continue;
+        }
+        if (!len) continue;
+        uint32_t seq;
+        size_t page_len = cobs_decode(frame, len, page, sizeof(page));
+        len = 0;
+        check(page_len && flash_log_page_valid(page, page_len, &seq), "quadro do dump invalido");
+        if (!page_len || !flash_log_page_valid(page, page_len, &seq)) continue;
+        if (*pages && seq != last_seq + 1) gaps++;
+        last_seq = seq;
+        if (*pages <= PAGES) {
+            page_seqs[*pages] = seq;
+            page_starts[*pages] = n;
+        }
+        (*pages)++;
+
+        flash_log_cursor_t cursor;
+        flash_log_cursor_init(&cursor, page);
+        while (n < sizeof(decoded) / sizeof(decoded[0]) && flash_log_cursor_next(&cursor, &decoded[n])) n++;
+    }
+    if (*pages <= PAGES) page_starts[*pages] = n;
+    return n;
+}
+
+static bool same_entry(const flash_log_entry_t *a, const flash_log_entry_t *b) {
+    return a->timestamp_ms == b->timestamp_ms && !memcmp(a->raw, b->raw, sizeof(a->raw)) && a->cor == b->cor &&
+           a->mode == b->mode && a->alert == b->alert;
+}
+
+int main(void) {
+    uint32_t pages;
+
+    sim_init();
+    srand(1);
+
+    flash_log_init();
+    for (uint32_t i = 0; i < SAMPLES; i++) {
+        sample_record_t s = random_sample(i, &written[i]);
+        flash_log_append(&s);
+    }
+
+    dump_len = 0;
+    flash_log_dump(capture);
+    size_t n = decode_dump(&pages);
+    check(gaps == 0, "sequencia de paginas com buraco");
+    check(n > 0 && n < SAMPLES, "dump deveria conter só o final do log");
+    for (size_t k = 0; k < n; k++) {
+        check(same_entry(&decoded[k], &written[SAMPLES - n + k]), "entrada do dump diferente da gravada");
+    }
+    printf("%u paginas, %zu de %d amostras no dump (%.1f bytes/amostra)\n", pages, n, SAMPLES,
+           (double)pages * FLASH_PAGE_SIZE / n);
+
+    // Desgaste: todos os setores da região apagados o mesmo número de vezes (±1)
+    uint32_t first = FLASH_LOG_OFFSET / FLASH_SECTOR_SIZE, min = UINT32_MAX, max = 0;
+    for (uint32_t s = first; s < first + FLASH_LOG_SECTORS; s++) {
+        uint32_t c = sim_flash_erase_count(s);
+        if (c < min) min = c;
+        if (c > max) max = c;
+    }
+    printf("apagamentos por setor: %u a %u\n", min, max);
+    check(min >= 2 && max - min <= 1, "desgaste desigual entre os setores");
+
+    // "Reboot": a página na RAM se perde; o log continua na página seguinte à mais recente
+    flash_log_init();
+    for (uint32_t i = SAMPLES; i < SAMPLES + REBOOT_SAMPLES; i++) {
+        sample_record_t s = random_sample(i, &written[i]);
+        flash_log_append(&s);
+    }
+    dump_len = 0;
+    flash_log_dump(capture);
+    n = decode_dump(&pages);
+    check(gaps == 0, "sequencia de paginas com buraco depois do reboot");
+    size_t boot = n;
+    for (size_t k = 0; k < n; k++) {
+        if (decoded[k].boot) boot = k;
+    }
+    check(boot == n - REBOOT_SAMPLES, "marca de boot fora do lugar");
+    for (size_t k = boot; k < n; k++) {
+        check(same_entry(&decoded[k], &written[SAMPLES + k - boot]), "entrada depois do reboot diferente");
+    }
+
+    // Página corrompida no meio do log: descartada pelo CRC. O dump pula só ela, com as
+    // vizinhas em ordem, e a escrita continua depois da página mais recente.
+    flash_log_init(); // Descarta a página na RAM: o dump fica só com as páginas da flash
+    dump_len = 0;
+    flash_log_dump(capture);
+    size_t n_before = decode_dump(&pages);
+    memcpy(before, decoded, n_before * sizeof(before[0]));
+    uint32_t newest_seq = page_seqs[pages - 1], victim_seq = page_seqs[pages / 2];
+    size_t victim_first = page_starts[pages / 2];
+    size_t victim_count = page_starts[pages / 2 + 1] - victim_first;
+
+    uint8_t *victim = NULL;
+    for (uint32_t i = 0; i < PAGES; i++) {
+        uint8_t *p = sim_flash_memory + FLASH_LOG_OFFSET + i * FLASH_PAGE_SIZE;
+        uint32_t seq;
+        if (flash_log_page_valid(p, FLASH_PAGE_SIZE, &seq) && seq == victim_seq) victim = p;
+    }
+    check(victim != NULL, "pagina do meio do log nao encontrada na flash");
+    if (victim) {
+        uint32_t seq;
+        victim[FLASH_LOG_HEADER_LEN + 3] ^= 0x10;
+        check(!flash_log_page_valid(victim, FLASH_PAGE_SIZE, &seq), "pagina corrompida aceita");
+    }
+
+    flash_log_init();
+    dump_len = 0;
+    flash_log_dump(capture);
+    n = decode_dump(&pages);
+    check(gaps == 1 && n == n_before - victim_count, "dump deveria perder so a pagina corrompida");
+    for (size_t k = 0; k < n && k + victim_count < n_before; k++) {
+        const flash_log_entry_t *want = &before[k < victim_first ? k : k + victim_count];
+        check(same_entry(&decoded[k], want), "vizinha da pagina corrompida diferente");
+    }
+    check(page_seqs[pages - 1] == newest_seq, "pagina mais recente mudou");
+
+    sample_record_t s = random_sample(SAMPLES, &written[SAMPLES]);
+    flash_log_append(&s);
+    dump_len = 0;
+    flash_log_dump(capture);
+    n = decode_dump(&pages);
+    check(page_seqs[pages - 1] == newest_seq + 1 && decoded[n - 1].boot && same_entry(&decoded[n - 1], &written[SAMPLES]),
+          "escrita deveria continuar depois da pagina mais recente");
+
+    // Gravação que falha: a página cheia fica na RAM e é gravada na tentativa seguinte; as
+    // amostras que chegam enquanto isso são descartadas e contadas
+    flash_log_init();
+    dump_len = 0;
+    flash_log_dump(capture);
+    decode_dump(&pages);
+    unsigned gaps_before = gaps; // A página corrompida acima continua na flash
+    flash_log_stats_t stats_before = flash_log_stats();
+    sim_flash_fail_safe_execute(2);
+    size_t kept = 0;
+    for (uint32_t i = 0; i < 200; i++) {
+        uint32_t dropped = flash_log_stats().dropped_samples;
+        s = random_sample(SAMPLES + 1 + i, &written[kept]);
+        flash_log_append(&s);
+        if (flash_log_stats().dropped_samples == dropped) kept++;
+    }
+    flash_log_stats_t stats_after = flash_log_stats();
+    check(stats_after.failed_writes - stats_before.failed_writes == 2 &&
+          stats_after.dropped_samples - stats_before.dropped_samples == 2 && kept == 198,
+          "falhas de gravacao nao contadas");
+    dump_len = 0;
+    flash_log_dump(capture);
+    n = decode_dump(&pages);
+    check(gaps == gaps_before && n >= kept, "pagina perdida depois de falha de gravacao");
+    for (size_t k = 0; k < kept && n >= kept; k++) {
+        check(same_entry(&decoded[n - kept + k], &written[k]), "entrada diferente depois de falha de gravacao");
+    }
+
+    printf("%lu falhas\n", errors);
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "gy33.h"
+#include "config.h"
+#include "sim.h"
+
+// Exposição automática do GY-33 contra o modelo do TCS34725: para cenas do escuro à luz
+// forte, o controle converge sem oscilar, nenhuma leitura é usada antes de a integração com
+// a exposição nova terminar, a luz forte encurta a integração e as leituras normalizadas
+// ficam na escala da exposição de referência (a mesma cor em qualquer exposição).
+
+#define READS 16
+#define COUNTS_DIVISOR 50 // Mesma escala do modelo em host/src/sim_gy33.c
+
+static unsigned long errors = 0;
+
+static void check(bool ok, const char *what, unsigned lux) {
+    if (!ok) {
+        errors++;
+        printf("falha: %s (lux %u)\n", what, lux);
+    }
+}
+
+// Contagem de um canal na exposição de referência, sem saturação
+static double reference_counts(unsigned lux, unsigned channel) {
+    return (double)lux * GY33_REFERENCE_EXPOSURE * channel / (255.0 * COUNTS_DIVISOR);
+}
+
+int main(void) {
+    static const unsigned luxes[] = {3, 20, 100, 300, 1000, 5000, 20000};
+    static const uint8_t colors[][3] = {{255, 80, 0}, {40, 200, 255}};
+
+    sim_init();
+    i2c_init(I2C_PORT_SENSORS, 400 * 1000);
+
+    for (unsigned k = 0; k < sizeof(colors) / sizeof(colors[0]); k++) {
+        for (unsigned i = 0; i < sizeof(luxes) / sizeof(luxes[0]); i++) {
+            unsigned lux = luxes[i];
+            unsigned changes_late = 0, invalid = 0;
+            uint16_t clear = 0;
+            gy33_color_t color = {0};
+            bool changed = false;
+
+            sim_set_scene(lux, colors[k][0], colors[k][1], colors[k][2]);
+            gy33_init();
+            sleep_us(gy33_integration_time_us() + GY33_RESTART_US);
+
+            for (int n = 0; n < READS; n++) {
+                if (!gy33_read_color_burst(&color)) {
+                    invalid++;
+                } else {
+                    clear = color.c;
+                    gy33_normalize(&color);
+                    changed = gy33_auto_exposure(clear);
+                    if (changed && n >= READS / 2) changes_late++;
+                }
+                sleep_us(gy33_integration_time_us() + (changed ? GY33_RESTART_US : 0));
+            }
+
+            check(invalid == 0, "leitura antes do fim da integracao", lux);
+            check(changes_late == 0, "exposicao nao convergiu", lux);
+
+            // Na faixa alvo, salvo nos extremos da escada
+            uint32_t full = (gy33_integration_time_us() / GY33_ATIME_CYCLE_US) * 1024;
+            if (full > 65535) full = 65535;
+            bool in_band = clear * 100 >= full * 10 && clear * 100 <= full * 75;
+            check(in_band || gy33_exposure() == 1 * 10 || gy33_exposure() == 60 * 100, "clear fora da faixa", lux);
+            if (lux >= 5000) check(gy33_integration_time_us() == 10 * GY33_ATIME_CYCLE_US, "luz forte sem integracao curta", lux);
+
+            // Normalização: mesma escala da referência; acima de 16 bits, a proporção entre os canais
+            double r = reference_counts(lux, colors[k][0]), g = reference_counts(lux, colors[k][1]);
+            double b = reference_counts(lux, colors[k][2]), c = r + g + b;
+            if (c <= 65535) {
+                double tolerance = 0.02 * c + 2 + GY33_REFERENCE_EXPOSURE / (double)gy33_exposure();
+                check(abs((int)color.c - (int)c) <= tolerance && abs((int)color.r - (int)r) <= tolerance,
+                      "leitura normalizada fora da escala de referencia", lux);
+            } else {
+                check(color.c == 65535 && abs((int)color.r - (int)(65535 * r / c)) <= 0.01 * 65535,
+                      "saturacao nao preservou a proporcao entre os canais", lux);
+            }
+
+            printf("lux %5u cor %3u,%3u,%3u: exposicao %4lu (%3lu ms), clear bruto %5u, normalizado %5u %5u %5u %5u\n", lux,
+                   colors[k][0], colors[k][1], colors[k][2], (unsigned long)gy33_exposure(),
+                   (unsigned long)gy33_integration_time_us() / 1000, clear, color.c, color.r, color.g, color.b);
+        }
+    }
+
+    printf("%lu falhas\n", errors);
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,68 @@
+#include <stdio.h>
+#include "color_utils.h"
+
+// Compara RGBtoHSV_fixed/identificar_cor_hsv_fixed com a versão em float em todo o
+// cubo RGB 0..255³: a classe identificada e o critério de cor intensa devem ser idênticos.
+// Também refaz, a partir de RGBtoHSV(), as tabelas de empates de color_utils.c: cada marca
+// em hsv.empates deve aparecer exatamente nos empates em que o float muda a classe.
+
+// Hue exato num grau em que a classe de LIMIARES_COR_PADRAO muda, com o float logo abaixo
+static int hue_abaixo_esperado(int r, int g, int b, float h) {
+    int cmax = r > g ? (r > b ? r : b) : (g > b ? g : b);
+    int cmin = r < g ? (r < b ? r : b) : (g < b ? g : b);
+    int diff = cmax - cmin, num;
+    if (diff == 0) return 0;
+    if (cmax == r) {
+        num = 60 * (g - b) + 360 * diff;
+    } else if (cmax == g) {
+        num = 60 * (b - r) + 120 * diff;
+    } else {
+        num = 60 * (r - g) + 240 * diff;
+    }
+    if (num % diff) return 0;
+    int grau = num / diff % 360, anterior = (grau + 359) % 360;
+    return (int)h != grau && limiares_cor_padrao.cor_por_grau[grau] != limiares_cor_padrao.cor_por_grau[anterior];
+}
+
+int main(void) {
+    unsigned long mismatches = 0, intensity_mismatches = 0, tie_mismatches = 0;
+
+    for (int r = 0; r < 256; r++) {
+        for (int g = 0; g < 256; g++) {
+            for (int b = 0; b < 256; b++) {
+                float h, s, v;
+                CorHSV hsv;
+                RGBtoHSV(r, g, b, &h, &s, &v);
+                RGBtoHSV_fixed(r, g, b, &hsv);
+
+                CorIdentificada expected = identificar_cor_hsv(h, s, v);
+                CorIdentificada actual = identificar_cor_hsv_fixed(&hsv, &limiares_cor_padrao);
+                if (expected != actual) {
+                    if (mismatches < 10) {
+                        printf("classe: RGB(%d, %d, %d) float=%d fixo=%d (h=%f s=%f v=%f, h_q=%u)\n", r, g, b,
+                               expected, actual, h, s, v, hsv.h);
+                    }
+                    mismatches++;
+                }
+                int empates = (hue_abaixo_esperado(r, g, b, h) ? HSV_EMPATE_H_ABAIXO : 0) |
+                              (hsv.v && hsv.c * 4 == hsv.v && s < 0.25f ? HSV_EMPATE_S_ABAIXO : 0);
+                if (hsv.empates != empates) {
+                    if (tie_mismatches < 10) {
+                        printf("empate: RGB(%d, %d, %d) marcado 0x%02X, esperado 0x%02X\n", r, g, b, hsv.empates, empates);
+                    }
+                    tie_mismatches++;
+                }
+                if ((s > 0.6f && v > 0.7f) != (cor_hsv_intensa(&hsv, &limiares_cor_padrao) != 0)) {
+                    if (intensity_mismatches < 10) {
+                        printf("intensa: RGB(%d, %d, %d) s=%f v=%f\n", r, g, b, s, v);
+                    }
+                    intensity_mismatches++;
+                }
+            }
+        }
+    }
+
+    printf("%lu divergencias de classe, %lu de intensidade, %lu de empates em 16777216 cores\n", mismatches,
+           intensity_mismatches, tie_mismatches);
+    return (mismatches || intensity_mismatches || tie_mismatches) ? 1 : 0;
+}
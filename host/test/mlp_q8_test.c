@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <string.h>
+#include "ambient_model.h"
+
+// Compara forward_q8 (int8/Q15) com forward_const (float) em todo o cubo RGB 0..255³:
+// reporta o desvio máximo das saídas e a concordância da classificação. Também confere
+// que ambient_model_q8.c está em dia com quantize_mlp sobre os pesos de ambient_model.c.
+
+#define WEIGHTS_LEN MLP_Q8_WEIGHTS_LEN(AMBIENT_INPUT_LEN, AMBIENT_HIDDEN_LEN, AMBIENT_OUTPUT_LEN)
+#define BIASES_LEN MLP_Q8_BIASES_LEN(AMBIENT_INPUT_LEN, AMBIENT_HIDDEN_LEN, AMBIENT_OUTPUT_LEN)
+
+// Limites aceitos para o modelo quantizado (pesos int8 com uma escala por camada: o passo
+// de quantização da camada oculta é ~0,1, então as divergências ficam perto das fronteiras)
+#define MAX_OUTPUT_DEVIATION 0.08f
+#define MIN_MODE_AGREEMENT 0.99
+
+// Mesma regra de get_ambient_mode() (sem a verificação de lux): saída >= 0,95 e as demais <= 0,05
+static int mode_float(const float *o) {
+    for (int i = 0; i < AMBIENT_OUTPUT_LEN; i++) {
+        if (o[i] < 0.95f) continue;
+        int others_are_zero = 1;
+        for (int j = 0; j < AMBIENT_OUTPUT_LEN; j++) {
+            if (j != i && o[j] > 0.05f) others_are_zero = 0;
+        }
+        if (others_are_zero) return i;
+    }
+    return 3;
+}
+
+static int mode_q15(const int16_t *o) {
+    float f[AMBIENT_OUTPUT_LEN];
+    for (int i = 0; i < AMBIENT_OUTPUT_LEN; i++) f[i] = o[i] / (float)MLP_Q15_ONE;
+    return mode_float(f);
+}
+
+static int argmax_float(const float *o) {
+    int best = 0;
+    for (int i = 1; i < AMBIENT_OUTPUT_LEN; i++) if (o[i] > o[best]) best = i;
+    return best;
+}
+
+static int argmax_q15(const int16_t *o) {
+    int best = 0;
+    for (int i = 1; i < AMBIENT_OUTPUT_LEN; i++) if (o[i] > o[best]) best = i;
+    return best;
+}
+
+int main(void) {
+    static int8_t weights[WEIGHTS_LEN];
+    static int32_t biases[BIASES_LEN];
+    MLPQ8 q;
+
+    quantize_mlp(&ambient_model, &q, weights, biases);
+    if (memcmp(weights, ambient_model_q8.weights, sizeof(weights)) ||
+        memcmp(biases, ambient_model_q8.biases, sizeof(biases)) ||
+        q.hidden_scale.multiplier != ambient_model_q8.hidden_scale.multiplier ||
+        q.hidden_scale.shift != ambient_model_q8.hidden_scale.shift ||
+        q.output_scale.multiplier != ambient_model_q8.output_scale.multiplier ||
+        q.output_scale.shift != ambient_model_q8.output_scale.shift) {
+        printf("ambient_model_q8.c desatualizado: regenere com mlp_quantize\n");
+        return 1;
+    }
+
+    float max_dev[AMBIENT_OUTPUT_LEN] = {0};
+    unsigned long argmax_agree = 0, mode_agree = 0, total = 0;
+
+    for (int r = 0; r < 256; r++) {
+        for (int g = 0; g < 256; g++) {
+            for (int b = 0; b < 256; b++) {
+                float X[AMBIENT_INPUT_LEN] = {r / 255.0f, g / 255.0f, b / 255.0f};
+                int16_t Xq[AMBIENT_INPUT_LEN] = {
+                    MLP_Q15_FROM_U8(r),
+                    MLP_Q15_FROM_U8(g),
+                    MLP_Q15_FROM_U8(b),
+                };
+                float hidden[AMBIENT_HIDDEN_LEN], out[AMBIENT_OUTPUT_LEN];
+                int16_t hidden_q[AMBIENT_HIDDEN_LEN], out_q[AMBIENT_OUTPUT_LEN];
+
+                forward_const(&ambient_model, X, hidden, out);
+                forward_q8(&ambient_model_q8, Xq, hidden_q, out_q);
+
+                for (int k = 0; k < AMBIENT_OUTPUT_LEN; k++) {
+                    float dev = out[k] - out_q[k] / (float)MLP_Q15_ONE;
+                    if (dev < 0) dev = -dev;
+                    if (dev > max_dev[k]) max_dev[k] = dev;
+                }
+                argmax_agree += argmax_float(out) == argmax_q15(out_q);
+                mode_agree += mode_float(out) == mode_q15(out_q);
+                total++;
+            }
+        }
+    }
+
+    float worst = 0;
+    printf("desvio maximo por saida:");
+    for (int k = 0; k < AMBIENT_OUTPUT_LEN; k++) {
+        printf(" %.5f", max_dev[k]);
+        if (max_dev[k] > worst) worst = max_dev[k];
+    }
+    printf("\nconcordancia argmax: %lu/%lu (%.4f%%)\n", argmax_agree, total, 100.0 * argmax_agree / total);
+    printf("concordancia do modo: %lu/%lu (%.4f%%)\n", mode_agree, total, 100.0 * mode_agree / total);
+
+    return (worst > MAX_OUTPUT_DEVIATION || (double)mode_agree / total < MIN_MODE_AGREEMENT) ? 1 : 0;
+}
@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <string.h>
+#include "runtime_config.h"
+#include "config.h"
+#include "hardware/flash.h"
+#include "sim.h"
+
+// Configuração em flash: padrão sem nada gravado, alternância entre os dois setores, recuperação
+// da anterior quando a gravação mais nova está corrompida ou incompleta, rejeição de valores
+// inválidos e troca entre os núcleos (só vale depois de runtime_config_sync).
+
+static unsigned long errors = 0;
+
+static void check(bool ok, const char *what) {
+    if (!ok) {
+        errors++;
+        printf("falha: %s\n", what);
+    }
+}
+
+static uint8_t *slot(int i) {
+    return sim_flash_memory + FLASH_CONFIG_OFFSET + i * FLASH_SECTOR_SIZE;
+}
+
+int main(void) {
+    sim_init();
+
+    check(!runtime_config_load(), "flash apagada deveria dar a configuracao padrao");
+    check(!memcmp(&runtime_config, &runtime_config_default, sizeof(runtime_config)), "padrao diferente");
+    check(!memcmp(&runtime_config.cor, &limiares_cor_padrao, sizeof(LimiaresCor)), "limiares de cor padrao");
+    check(runtime_config.luminosity_threshold == LUMINOSITY_THRESHOLD && runtime_config.color_max_value == SENSOR_COLOR_MAX_VALUE,
+          "padroes de config.h");
+
+    // Alteração só vale no núcleo 0 depois de publicada e sincronizada
+    check(runtime_config_command("cfg set lux_min 50"), "cfg set");
+    check(runtime_config_command("cfg set work_lux_max 800"), "cfg set faixa de modo");
+    runtime_config_sync();
+    check(runtime_config.luminosity_threshold == LUMINOSITY_THRESHOLD, "valor aplicado antes do save");
+    check(runtime_config_command("cfg save"), "cfg save");
+    check(runtime_config.luminosity_threshold == LUMINOSITY_THRESHOLD, "valor aplicado antes do sync");
+    check(!runtime_config_command("cfg set lux_min 60") || !runtime_config_command("cfg apply"),
+          "publicacao nova antes do sync deveria ser recusada");
+    runtime_config_sync();
+    check(runtime_config.luminosity_threshold == 50 && runtime_config.mode_lux[1][1] == 800, "valor depois do sync");
+
+    // Primeira gravação no setor 0; a segunda vai para o setor 1
+    check(runtime_config_load() && runtime_config.luminosity_threshold == 50, "recarga do setor 0");
+    check(runtime_config_command("cfg hue azul 200 260") && runtime_config_command("cfg hue vermelho 350 10"), "cfg hue");
+    check(runtime_config_command("cfg set lux_min 60") && runtime_config_command("cfg save"), "segundo save");
+    check(slot(1)[0] != 0xFF, "segunda gravacao deveria ir para o setor 1");
+    check(runtime_config_load() && runtime_config.luminosity_threshold == 60, "recarga do setor 1");
+    check(runtime_config.cor.cor_por_grau[200] == AZUL && runtime_config.cor.cor_por_grau[259] == AZUL &&
+          runtime_config.cor.cor_por_grau[260] == INDEFINIDO, "faixa azul (fim exclusivo)");
+    check(runtime_config.cor.cor_por_grau[255] == AZUL && runtime_config.cor.cor_por_grau[9] == VERMELHO &&
+          runtime_config.cor.cor_por_grau[352] == VERMELHO, "faixas pintadas");
+
+    // Valores que quebrariam o caminho quente são recusados e não chegam à flash
+    check(!runtime_config_command("cfg set lux_max 10") || !runtime_config_command("cfg save"), "lux_max <= lux_min aceito");
+    check(!runtime_config_command("cfg set color_max 70000"), "valor fora de 16 bits aceito");
+    check(!runtime_config_command("cfg set nada 1"), "chave desconhecida aceita");
+    check(!runtime_config_command("cfg hue roxo 0 10"), "cor desconhecida aceita");
+    check(runtime_config_load() && runtime_config.luminosity_max == LUMINOSITY_MAX, "valor invalido gravado");
+
+    // Gravação interrompida (setor 1 apagado) ou corrompida: volta para a do setor 0
+    uint8_t saved = slot(1)[40];
+    slot(1)[40] ^= 0x01;
+    check(runtime_config_load() && runtime_config.luminosity_threshold == 50, "setor corrompido deveria cair no anterior");
+    slot(1)[40] = saved;
+    memset(slot(1), 0xFF, FLASH_SECTOR_SIZE);
+    check(runtime_config_load() && runtime_config.luminosity_threshold == 50, "setor apagado deveria cair no anterior");
+
+    // A próxima gravação sobrescreve o setor que não tem a atual
+    check(runtime_config_command("cfg defaults") && runtime_config_command("cfg save"), "save dos padroes");
+    check(runtime_config_load() && !memcmp(&runtime_config, &runtime_config_default, sizeof(runtime_config)),
+          "recarga dos padroes");
+    memset(slot(0), 0xFF, FLASH_SECTOR_SIZE);
+    check(runtime_config_load(), "setor 1 deveria continuar valido");
+
+    printf("%lu falhas\n", errors);
+    return errors ? 1 : 0;
+}
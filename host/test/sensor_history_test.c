@@ -0,0 +1,78 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "sensor_history.h"
+
+// Compara as estatísticas incrementais de sensor_history com o recálculo direto sobre a
+// janela, a cada push, em sequências aleatórias (com trechos constantes e repetições,
+// que exercitam os empates das filas monotônicas e da janela ordenada).
+
+#define STEPS 200000
+#define EWMA_SHIFT 2
+
+static int cmp_u16(const void *a, const void *b) {
+    return (int)*(const uint16_t *)a - (int)*(const uint16_t *)b;
+}
+
+int main(void) {
+    static uint16_t values[STEPS][SENSOR_CHANNELS];
+    sensor_history_t h;
+    uint32_t ewma_q8[SENSOR_CHANNELS] = {0};
+    unsigned long errors = 0;
+
+    srand(1);
+    for (int i = 0; i < STEPS; i++) {
+        for (int ch = 0; ch < SENSOR_CHANNELS; ch++) {
+            int r = rand() % 10;
+            if (i && r < 3) values[i][ch] = values[i - 1][ch];             // Repete
+            else if (r < 5) values[i][ch] = (uint16_t)(rand() % 8);         // Poucos valores distintos
+            else values[i][ch] = (uint16_t)(rand() % 65536);
+        }
+    }
+
+    sensor_history_init(&h, EWMA_SHIFT);
+    for (int i = 0; i < STEPS; i++) {
+        sensor_history_push(&h, (uint32_t)i * 100, values[i]);
+        uint n = i + 1 < SENSOR_HISTORY_LEN ? i + 1 : SENSOR_HISTORY_LEN;
+
+        if (sensor_history_size(&h) != n || sensor_history_get(&h, 0)->timestamp_ms != (uint32_t)i * 100 ||
+            sensor_history_get(&h, n - 1)->timestamp_ms != (uint32_t)(i - (int)n + 1) * 100 ||
+            sensor_history_get(&h, n) != NULL) {
+            printf("passo %d: tamanho/idades errados\n", i);
+            errors++;
+        }
+
+        for (int ch = 0; ch < SENSOR_CHANNELS; ch++) {
+            uint16_t window[SENSOR_HISTORY_LEN];
+            uint32_t sum = 0;
+            uint16_t mn = 65535, mx = 0;
+            for (uint k = 0; k < n; k++) {
+                window[k] = values[i - k][ch];
+                sum += window[k];
+                if (window[k] < mn) mn = window[k];
+                if (window[k] > mx) mx = window[k];
+            }
+            qsort(window, n, sizeof(uint16_t), cmp_u16);
+            uint16_t median = (uint16_t)((window[(n - 1) / 2] + window[n / 2]) / 2);
+            uint16_t mean = (uint16_t)((sum + n / 2) / n);
+
+            if (i == 0) ewma_q8[ch] = (uint32_t)values[i][ch] << 8;
+            else ewma_q8[ch] += (((int32_t)values[i][ch] << 8) - (int32_t)ewma_q8[ch]) >> EWMA_SHIFT;
+            uint16_t ewma = (uint16_t)((ewma_q8[ch] + 128) >> 8);
+
+            if (sensor_history_mean(&h, ch) != mean || sensor_history_min(&h, ch) != mn ||
+                sensor_history_max(&h, ch) != mx || sensor_history_median(&h, ch) != median ||
+                sensor_history_ewma(&h, ch) != ewma) {
+                if (errors < 10) {
+                    printf("passo %d canal %d: media %u/%u min %u/%u max %u/%u mediana %u/%u ewma %u/%u\n", i, ch,
+                           sensor_history_mean(&h, ch), mean, sensor_history_min(&h, ch), mn,
+                           sensor_history_max(&h, ch), mx, sensor_history_median(&h, ch), median,
+                           sensor_history_ewma(&h, ch), ewma);
+                }
+                errors++;
+            }
+        }
+    }
+
+    printf("%lu divergencias em %d passos x %d canais\n", errors, STEPS, SENSOR_CHANNELS);
+    return errors ? 1 : 0;
+}
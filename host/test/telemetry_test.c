@@ -0,0 +1,75 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "telemetry.h"
+
+// Ida e volta do COBS com dados aleatórios (inclusive trechos longos sem zero e só de
+// zeros), ida e volta de quadros de telemetria e detecção de quadros corrompidos.
+
+static unsigned long errors = 0;
+
+static void check(bool ok, const char *what, int i) {
+    if (!ok && errors++ < 10) printf("falha: %s (caso %d)\n", what, i);
+}
+
+static void random_sample(sample_record_t *s) {
+    memset(s, 0, sizeof(*s));
+    s->timestamp_ms = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+    s->raw_c = rand() & 0xFFFF;
+    s->raw_r = rand() % 3 ? rand() & 0xFFFF : 0;
+    s->raw_g = rand() & 0xFFFF;
+    s->raw_b = rand() % 3 ? rand() & 0xFFFF : 0;
+    s->lux = rand() & 0xFFFF;
+    s->hsv.h = rand() % (360 << HSV_H_FRAC_BITS);
+    s->hsv.s = rand() % (HSV_S_ONE + 1);
+    s->hsv.v = rand() & 0xFF;
+    s->cor = rand() % (MAGENTA + 1);
+    s->mode = rand() % 4;
+    s->alert = rand() & 1;
+    for (int i = 0; i < AMBIENT_OUTPUT_LEN; i++) s->mlp_outputs[i] = (int16_t)(rand() & 0xFFFF);
+}
+
+int main(void) {
+    static uint8_t data[1000], encoded[COBS_MAX_ENCODED_LEN(1000)], decoded[1000];
+
+    srand(1);
+    for (int i = 0; i < 20000; i++) {
+        size_t len = rand() % sizeof(data);
+        int kind = rand() % 3;
+        for (size_t j = 0; j < len; j++) {
+            data[j] = kind == 0 ? rand() & 0xFF : kind == 1 ? 1 + rand() % 255 : (rand() % 8 ? 0 : 7);
+        }
+        size_t enc = cobs_encode(data, len, encoded);
+        check(enc <= COBS_MAX_ENCODED_LEN(len), "COBS acima do tamanho máximo", i);
+        check(memchr(encoded, 0, enc) == NULL, "zero na saída do COBS", i);
+        size_t dec = cobs_decode(encoded, enc, decoded, sizeof(decoded));
+        check(dec == len && !memcmp(data, decoded, len), "COBS ida e volta", i);
+    }
+
+    for (int i = 0; i < 20000; i++) {
+        sample_record_t in, out;
+        uint8_t frame[TELEMETRY_FRAME_MAX];
+
+        random_sample(&in);
+        size_t len = telemetry_encode(&in, frame);
+        check(len <= TELEMETRY_FRAME_MAX && frame[len - 1] == 0, "tamanho/delimitador do quadro", i);
+        check(memchr(frame, 0, len - 1) == NULL, "zero dentro do quadro", i);
+        check(telemetry_decode(frame, len - 1, &out), "quadro válido rejeitado", i);
+        check(out.timestamp_ms == in.timestamp_ms && out.raw_c == in.raw_c && out.raw_r == in.raw_r &&
+              out.raw_g == in.raw_g && out.raw_b == in.raw_b && out.lux == in.lux && out.hsv.h == in.hsv.h &&
+              out.hsv.s == in.hsv.s && out.hsv.v == in.hsv.v && out.cor == in.cor && out.mode == in.mode &&
+              out.alert == in.alert && !memcmp(out.mlp_outputs, in.mlp_outputs, sizeof(in.mlp_outputs)),
+              "campos do quadro", i);
+
+        // Um bit trocado (sem criar zero, que o delimitador já separaria) ou um byte a menos
+        size_t pos = rand() % (len - 1);
+        uint8_t orig = frame[pos];
+        frame[pos] ^= (uint8_t)(1 << (rand() % 8));
+        if (frame[pos] != 0) check(!telemetry_decode(frame, len - 1, &out), "bit trocado aceito", i);
+        frame[pos] = orig;
+        check(!telemetry_decode(frame, len - 2, &out), "quadro truncado aceito", i);
+    }
+
+    printf("%lu falhas\n", errors);
+    return errors ? 1 : 0;
+}
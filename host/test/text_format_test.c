@@ -0,0 +1,60 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "text_format.h"
+
+// Compara fmt_uint/fmt_int/fmt_decimal com o snprintf da libc: todos os valores de S (Q15)
+// e V (0..255) exibidos no OLED, e valores aleatórios em toda a faixa de int32.
+
+static unsigned long errors = 0;
+
+static void expect(const char *got, const char *want, const char *what) {
+    if (strcmp(got, want) && errors++ < 10) printf("%s: \"%s\", esperado \"%s\"\n", what, got, want);
+}
+
+int main(void) {
+    // Cabe a largura máxima de fmt_uint/fmt_int (uint8_t) ou um double com sinal e 6 decimais
+    char got[UINT8_MAX + 1], want[UINT8_MAX + 1];
+
+    for (uint32_t s = 0; s <= 32768; s++) {
+        fmt_decimal(got, (int32_t)s, 32768, 2);
+        snprintf(want, sizeof(want), "%.2f", s / 32768.0);
+        expect(got, want, "S");
+    }
+    for (uint32_t v = 0; v <= 255; v++) {
+        fmt_decimal(got, (int32_t)v, 255, 2);
+        snprintf(want, sizeof(want), "%.2f", v / 255.0);
+        expect(got, want, "V");
+    }
+
+    srand(1);
+    for (int i = 0; i < 1000000; i++) {
+        uint32_t u = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+        int32_t v = (int32_t)u >> (rand() % 32);
+        uint8_t width = rand() % 14;
+
+        uint32_t shifted = u >> (i % 32);
+        fmt_uint(got, shifted, width);
+        snprintf(want, sizeof(want), "%*lu", width, (unsigned long)shifted);
+        expect(got, want, "fmt_uint");
+
+        fmt_int(got, v, width);
+        snprintf(want, sizeof(want), "%*ld", width, (long)v);
+        expect(got, want, "fmt_int");
+
+        // Denominador potência de 2: v / den é exato em double, inclusive nos empates
+        uint32_t den = 1u << (rand() % 17);
+        uint8_t decimals = rand() % 7;
+        fmt_decimal(got, v, den, decimals);
+        snprintf(want, sizeof(want), "%.*f", decimals, (double)v / den);
+        expect(got, want, "fmt_decimal");
+    }
+
+    fmt_int(got, INT32_MIN, 0);
+    expect(got, "-2147483648", "INT32_MIN");
+    fmt_uint(fmt_str(got, "H:"), 7, 3);
+    expect(got, "H:  7", "encadeamento");
+
+    printf("%lu divergencias\n", errors);
+    return errors ? 1 : 0;
+}
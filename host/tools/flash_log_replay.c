@@ -0,0 +1,142 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "flash_log.h"
+#include "ambient_classifier.h"
+#include "color_utils.h"
+#include "runtime_config.h"
+#include "telemetry.h"
+#include "hardware/flash.h"
+
+// Reproduz no host as decisões registradas no log da flash. Lê o dump do comando 'd'
+// (quadros COBS, um por página), decodifica as amostras e as passa por classify_sample, o
+// mesmo código do firmware (medianas, RGBtoHSV_fixed, identificar_cor_hsv_fixed, alertas e
+// get_ambient_mode), comparando cor, modo e alerta com os registrados. O dump começa pela
+// configuração em uso no firmware (runtime_config.h), que a reprodução adota; um dump sem
+// ela é reproduzido com a configuração padrão. Uma mudança de configuração no meio do log não
+// fica registrada: amostras anteriores a ela podem divergir.
+//
+// O histórico de medianas recomeça no primeiro registro após um boot, quando a reprodução é
+// exata desde o início. No começo do dump e depois de uma página perdida, as primeiras
+// SENSOR_HISTORY_LEN - 1 amostras só aquecem o histórico e não são comparadas.
+//
+// Uso: host/flash_log_replay [--csv] [dump]   (sem arquivo, lê a entrada padrão)
+//      echo d | host/sensores-gy33-gy302-host --flash-image flash.img | host/flash_log_replay
+// Sai com 1 se alguma decisão divergir.
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+    const char *path = NULL;
+    bool csv = false;
+    FILE *in = stdin;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--csv")) csv = true;
+        else if (!path && argv[i][0] != '-') path = argv[i];
+        else {
+            fprintf(stderr, "uso: %s [--csv] [dump]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (path && !(in = fopen(path, "rb"))) {
+        perror(path);
+        return 1;
+    }
+
+    // Quadros de página do log ou da configuração, que é maior que uma página
+    static uint8_t frame[COBS_MAX_ENCODED_LEN(RUNTIME_CONFIG_RECORD_LEN) + 1];
+    uint8_t page[RUNTIME_CONFIG_RECORD_LEN];
+    runtime_config_t config = runtime_config_default;
+    size_t len = 0;
+    bool overflow = false, have_seq = false;
+    uint32_t last_seq = 0;
+    unsigned long pages = 0, bad_frames = 0, lost_pages = 0, boots = 0, configs = 0;
+    unsigned long entries = 0, compared = 0, warmup = 0, diff_cor = 0, diff_mode = 0, diff_alert = 0;
+    sensor_history_t history;
+    uint32_t pushes = 0;  // Amostras no histórico desde o último recomeço
+    bool exact = false;   // Histórico recomeçou num boot: igual ao do firmware desde o início
+    int ch;
+
+    if (csv) printf("timestamp_ms,lux,r,g,b,c,cor,modo,alerta,cor_replay,modo_replay,alerta_replay\n");
+
+    double t0 = now_s();
+    while ((ch = fgetc(in)) != EOF) {
+        if (ch != 0) {
+            if (len < sizeof(frame)) frame[len++] = (uint8_t)ch;
+            else overflow = true;
+            continue;
+        }
+
+        uint32_t seq;
+        size_t page_len = (len && !overflow) ? cobs_decode(frame, len, page, sizeof(page)) : 0;
+        if (page_len && runtime_config_decode(page, page_len, &config, NULL)) {
+            configs++;
+            len = 0;
+            continue;
+        }
+        bool valid = page_len && flash_log_page_valid(page, page_len, &seq);
+        if (len && !valid) bad_frames++;
+        len = 0;
+        overflow = false;
+        if (!valid) continue;
+
+        pages++;
+        if (have_seq && seq != last_seq + 1) {
+            lost_pages += seq - last_seq - 1;
+            pushes = 0; // Amostras perdidas: o histórico do firmware não é mais conhecido
+            exact = false;
+        }
+        have_seq = true;
+        last_seq = seq;
+
+        flash_log_cursor_t cursor;
+        flash_log_entry_t e;
+        flash_log_cursor_init(&cursor, page);
+        while (flash_log_cursor_next(&cursor, &e)) {
+            if (e.boot) {
+                boots++;
+                pushes = 0;
+                exact = true;
+            }
+            if (pushes == 0) sensor_history_init(&history, AMBIENT_HISTORY_EWMA_SHIFT);
+
+            sample_record_t s;
+            classify_sample(&history, &config, e.timestamp_ms, e.raw, &s);
+            pushes++;
+            entries++;
+
+            bool comparable = exact || pushes >= SENSOR_HISTORY_LEN;
+            if (comparable) {
+                compared++;
+                diff_cor += s.cor != e.cor;
+                diff_mode += s.mode != e.mode;
+                diff_alert += s.alert != e.alert;
+            } else {
+                warmup++;
+            }
+
+            if (csv) {
+                printf("%lu,%u,%u,%u,%u,%u,%s,%d,%d,", (unsigned long)e.timestamp_ms, e.raw[SENSOR_LUX],
+                       e.raw[SENSOR_RED], e.raw[SENSOR_GREEN], e.raw[SENSOR_BLUE], e.raw[SENSOR_CLEAR],
+                       obter_nome_para_cor(e.cor), e.mode, e.alert);
+                if (comparable) printf("%s,%d,%d\n", obter_nome_para_cor(s.cor), s.mode, s.alert);
+                else printf(",,\n");
+            }
+        }
+    }
+    double elapsed = now_s() - t0;
+    if (in != stdin) fclose(in);
+
+    unsigned long diverged = diff_cor + diff_mode + diff_alert;
+    fprintf(stderr, "%lu paginas (%lu perdidas, %lu quadros invalidos), %lu amostras, %lu boots, configuracao %s\n",
+            pages, lost_pages, bad_frames, entries, boots, configs ? "do dump" : "padrao");
+    fprintf(stderr, "%lu decisoes comparadas (%lu de aquecimento): %lu cor, %lu modo, %lu alerta divergentes\n", compared,
+            warmup, diff_cor, diff_mode, diff_alert);
+    fprintf(stderr, "%.0f amostras/s\n", elapsed > 0 ? entries / elapsed : 0.0);
+    return diverged ? 1 : 0;
+}
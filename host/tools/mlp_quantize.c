@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include "ambient_model.h"
+
+// Gera libs/src/ambient_model_q8.c a partir dos pesos float de ambient_model.c.
+// Uso: host/mlp_quantize > libs/src/ambient_model_q8.c
+
+#define WEIGHTS_LEN MLP_Q8_WEIGHTS_LEN(AMBIENT_INPUT_LEN, AMBIENT_HIDDEN_LEN, AMBIENT_OUTPUT_LEN)
+#define BIASES_LEN MLP_Q8_BIASES_LEN(AMBIENT_INPUT_LEN, AMBIENT_HIDDEN_LEN, AMBIENT_OUTPUT_LEN)
+
+static void print_weight_rows(const int8_t *w, int rows, int cols) {
+    for (int i = 0; i < rows; i++) {
+        printf("   ");
+        for (int j = 0; j < cols; j++) {
+            printf(" %d,", *w++);
+        }
+        printf("\n");
+    }
+}
+
+int main(void) {
+    static int8_t weights[WEIGHTS_LEN];
+    static int32_t biases[BIASES_LEN];
+    MLPQ8 q;
+
+    quantize_mlp(&ambient_model, &q, weights, biases);
+
+    printf("#include \"ambient_model.h\"\n\n");
+    printf("// Gerado por host/tools/mlp_quantize.c a partir de ambient_model.c; não editar à mão.\n");
+    printf("// Pesos int8 com escala por camada e bias na escala do acumulador (ver MLPQ8 em mlp.h).\n");
+    printf("static const int8_t ambient_model_q8_weights[MLP_Q8_WEIGHTS_LEN(AMBIENT_INPUT_LEN, AMBIENT_HIDDEN_LEN, AMBIENT_OUTPUT_LEN)] = {\n");
+    printf("    // Camada oculta: [AMBIENT_HIDDEN_LEN][AMBIENT_INPUT_LEN]\n");
+    print_weight_rows(weights, AMBIENT_HIDDEN_LEN, AMBIENT_INPUT_LEN);
+    printf("\n    // Camada de saída: [AMBIENT_OUTPUT_LEN][AMBIENT_HIDDEN_LEN]\n");
+    print_weight_rows(weights + AMBIENT_HIDDEN_LEN * AMBIENT_INPUT_LEN, AMBIENT_OUTPUT_LEN, AMBIENT_HIDDEN_LEN);
+    printf("};\n\n");
+
+    printf("static const int32_t ambient_model_q8_biases[MLP_Q8_BIASES_LEN(AMBIENT_INPUT_LEN, AMBIENT_HIDDEN_LEN, AMBIENT_OUTPUT_LEN)] = {\n");
+    printf("   ");
+    for (int i = 0; i < BIASES_LEN; i++) {
+        printf(" %ld,", (long)biases[i]);
+        if (i == AMBIENT_HIDDEN_LEN - 1) printf("\n   ");
+    }
+    printf("\n};\n\n");
+
+    printf("const MLPQ8 ambient_model_q8 = {\n");
+    printf("    .input_layer_length = AMBIENT_INPUT_LEN,\n");
+    printf("    .hidden_layer_length = AMBIENT_HIDDEN_LEN,\n");
+    printf("    .output_layer_length = AMBIENT_OUTPUT_LEN,\n");
+    printf("    .weights = ambient_model_q8_weights,\n");
+    printf("    .biases = ambient_model_q8_biases,\n");
+    printf("    .hidden_scale = { %ld, %d },\n", (long)q.hidden_scale.multiplier, q.hidden_scale.shift);
+    printf("    .output_scale = { %ld, %d },\n", (long)q.output_scale.multiplier, q.output_scale.shift);
+    printf("};\n");
+    return 0;
+}
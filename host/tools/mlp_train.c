@@ -0,0 +1,317 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "ambient_model.h"
+
+// Treina o MLP do modo do ambiente a partir de um CSV (r,g,b,lux,label) e gera
+// libs/src/ambient_model.c. Entradas r, g e b de 0 a 255 (como r_norm/g_norm/b_norm em
+// main.c), label 0 (Relax), 1 (Work) ou 2 (Party); o lux não entra no modelo, pois
+// get_ambient_mode() só o usa para validar a classe depois da inferência.
+//
+// Gradiente em mini-lote dividido entre threads (cada uma acumula num buffer próprio,
+// somados em ordem fixa, então o resultado não depende do escalonamento), com parada
+// antecipada pelo erro num conjunto separado.
+//
+// Uso: host/mlp_train amostras.csv [--hidden N] [--epochs N] [--batch N] [--lr X]
+//          [--threads N] [--holdout X] [--patience N] [--seed N] [--out arquivo]
+// Depois: host/mlp_quantize > libs/src/ambient_model_q8.c
+
+#define MAX_THREADS 64
+
+typedef struct {
+    float x[AMBIENT_INPUT_LEN];
+    float y[AMBIENT_OUTPUT_LEN];
+    int label;
+} sample_t;
+
+typedef struct {
+    const MLPConst *model;
+    const sample_t *samples;
+    const int *indices;
+    int count;
+    int weights_len;
+    float *grad;
+    float quad_error;
+} worker_t;
+
+static struct {
+    pthread_t thread;
+    worker_t work;
+} workers[MAX_THREADS];
+
+static pthread_barrier_t batch_start, batch_done;
+static int workers_quit;
+
+static void work_slice(worker_t *w) {
+    float hidden[w->model->hidden_layer_length], out[AMBIENT_OUTPUT_LEN];
+
+    memset(w->grad, 0, w->weights_len * sizeof(float));
+    w->quad_error = 0;
+    for (int i = 0; i < w->count; i++) {
+        const sample_t *s = &w->samples[w->indices[i]];
+        w->quad_error += accumulate_gradients(w->model, s->x, s->y, w->grad, hidden, out);
+    }
+}
+
+static void *worker_main(void *arg) {
+    worker_t *w = arg;
+    for (;;) {
+        pthread_barrier_wait(&batch_start);
+        if (workers_quit) return NULL;
+        work_slice(w);
+        pthread_barrier_wait(&batch_done);
+    }
+}
+
+static int load_csv(const char *path, sample_t **out) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+
+    int count = 0, capacity = 1024, line_no = 0;
+    sample_t *samples = malloc(capacity * sizeof(sample_t));
+    char line[256];
+
+    while (fgets(line, sizeof(line), f)) {
+        float r, g, b, lux;
+        int label;
+        line_no++;
+        if (sscanf(line, "%f,%f,%f,%f,%d", &r, &g, &b, &lux, &label) != 5) {
+            if (line_no > 1 && line[strspn(line, " \r\n")] != '\0') {
+                fprintf(stderr, "%s:%d: linha ignorada\n", path, line_no);
+            }
+            continue; // Cabeçalho ou linha vazia
+        }
+        if (label < 0 || label >= AMBIENT_OUTPUT_LEN) {
+            fprintf(stderr, "%s:%d: label %d fora de 0..%d\n", path, line_no, label, AMBIENT_OUTPUT_LEN - 1);
+            continue;
+        }
+        (void)lux;
+
+        if (count == capacity) {
+            capacity *= 2;
+            samples = realloc(samples, capacity * sizeof(sample_t));
+        }
+        sample_t *s = &samples[count++];
+        s->x[0] = r / 255.0f;
+        s->x[1] = g / 255.0f;
+        s->x[2] = b / 255.0f;
+        for (int k = 0; k < AMBIENT_OUTPUT_LEN; k++) s->y[k] = (k == label) ? 1.0f : 0.0f;
+        s->label = label;
+    }
+
+    fclose(f);
+    *out = samples;
+    return count;
+}
+
+static void shuffle(int *v, int n) {
+    for (int i = n - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int t = v[i];
+        v[i] = v[j];
+        v[j] = t;
+    }
+}
+
+// Erro quadrático médio e acerto (argmax) no conjunto de validação
+static float evaluate(const MLPConst *m, const sample_t *samples, const int *indices, int count, float *accuracy) {
+    float hidden[m->hidden_layer_length], out[AMBIENT_OUTPUT_LEN];
+    float quad_error = 0;
+    int hits = 0;
+
+    for (int i = 0; i < count; i++) {
+        const sample_t *s = &samples[indices[i]];
+        int best = 0;
+        forward_const(m, s->x, hidden, out);
+        for (int k = 0; k < AMBIENT_OUTPUT_LEN; k++) {
+            float e = s->y[k] - out[k];
+            quad_error += e * e;
+            if (out[k] > out[best]) best = k;
+        }
+        hits += best == s->label;
+    }
+    *accuracy = count ? (float)hits / count : 0;
+    return count ? quad_error / count : 0;
+}
+
+static void print_rows(FILE *f, const float *w, int rows, int cols) {
+    for (int i = 0; i < rows; i++) {
+        fprintf(f, "   ");
+        for (int j = 0; j < cols; j++) {
+            fprintf(f, " %f,", *w++);
+        }
+        fprintf(f, "\n");
+    }
+}
+
+static const char *activation_name(MLPActivation activation) {
+    switch (activation) {
+        case MLP_ACTIVATION_PWL: return "MLP_ACTIVATION_PWL";
+        case MLP_ACTIVATION_LUT: return "MLP_ACTIVATION_LUT";
+        default: return "MLP_ACTIVATION_LIBM";
+    }
+}
+
+// Mesmo formato de libs/src/ambient_model.c, com a ativação usada no treino e na validação
+static void emit_model(FILE *f, const float *w, int hidden, MLPActivation activation) {
+    fprintf(f, "#include \"ambient_model.h\"\n\n");
+    fprintf(f, "// Pesos do modelo treinado. Por ser const, o array fica na flash e é lido via XIP,\n");
+    fprintf(f, "// sem cópia para a RAM.\n");
+    fprintf(f, "static const float ambient_model_weights[MLP_CONST_WEIGHTS_LEN(AMBIENT_INPUT_LEN, AMBIENT_HIDDEN_LEN, AMBIENT_OUTPUT_LEN)] = {\n");
+    fprintf(f, "    // Camada oculta: [AMBIENT_HIDDEN_LEN][AMBIENT_INPUT_LEN + 1]\n");
+    print_rows(f, w, hidden, AMBIENT_INPUT_LEN + 1);
+    fprintf(f, "\n    // Camada de saída: [AMBIENT_OUTPUT_LEN][AMBIENT_HIDDEN_LEN + 1]\n");
+    print_rows(f, w + hidden * (AMBIENT_INPUT_LEN + 1), AMBIENT_OUTPUT_LEN, hidden + 1);
+    fprintf(f, "};\n\n");
+    fprintf(f, "const MLPConst ambient_model = {\n");
+    fprintf(f, "    .input_layer_length = AMBIENT_INPUT_LEN,\n");
+    fprintf(f, "    .hidden_layer_length = AMBIENT_HIDDEN_LEN,\n");
+    fprintf(f, "    .output_layer_length = AMBIENT_OUTPUT_LEN,\n");
+    fprintf(f, "    // Mesma ativação do treino; as aproximações mudam decisões de modo (host/bench/activation_bench.c)\n");
+    fprintf(f, "    .activation = %s,\n", activation_name(activation));
+    fprintf(f, "    .weights = ambient_model_weights,\n");
+    fprintf(f, "};\n");
+}
+
+int main(int argc, char **argv) {
+    const char *csv = NULL, *out_path = NULL;
+    int hidden = AMBIENT_HIDDEN_LEN, epochs = 5000, batch = 64, threads = 4, patience = 200;
+    float lr = 2.0f, holdout = 0.2f;
+    unsigned int seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        const char *v = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (a[0] != '-') { csv = a; continue; }
+        if (!v) { fprintf(stderr, "%s sem valor\n", a); return 2; }
+        if (!strcmp(a, "--hidden")) hidden = atoi(v);
+        else if (!strcmp(a, "--epochs")) epochs = atoi(v);
+        else if (!strcmp(a, "--batch")) batch = atoi(v);
+        else if (!strcmp(a, "--lr")) lr = strtof(v, NULL);
+        else if (!strcmp(a, "--threads")) threads = atoi(v);
+        else if (!strcmp(a, "--holdout")) holdout = strtof(v, NULL);
+        else if (!strcmp(a, "--patience")) patience = atoi(v);
+        else if (!strcmp(a, "--seed")) seed = (unsigned int)strtoul(v, NULL, 10);
+        else if (!strcmp(a, "--out")) out_path = v;
+        else { fprintf(stderr, "opção desconhecida: %s\n", a); return 2; }
+        i++;
+    }
+    if (!csv || hidden < 1 || batch < 1 || threads < 1 || threads > MAX_THREADS || holdout < 0 || holdout >= 1) {
+        fprintf(stderr, "uso: %s amostras.csv [--hidden N] [--epochs N] [--batch N] [--lr X] [--threads 1..%d]\n"
+                        "       [--holdout 0..1] [--patience N] [--seed N] [--out arquivo]\n", argv[0], MAX_THREADS);
+        return 2;
+    }
+
+    sample_t *samples;
+    int count = load_csv(csv, &samples);
+    if (count <= 0) {
+        fprintf(stderr, "%s: nenhuma amostra\n", csv);
+        return 1;
+    }
+
+    MLP mlp;
+    model(&mlp, AMBIENT_INPUT_LEN, hidden, AMBIENT_OUTPUT_LEN, MLP_ACTIVATION_LIBM, epochs, lr, 0);
+    init_weights(&mlp, seed); // Reprodutível com --seed
+
+    int weights_len = MLP_CONST_WEIGHTS_LEN(AMBIENT_INPUT_LEN, hidden, AMBIENT_OUTPUT_LEN);
+    float *weights = malloc(weights_len * sizeof(float));
+    float *best = malloc(weights_len * sizeof(float));
+    float *grad = malloc(weights_len * sizeof(float));
+    export_weights(&mlp, weights);
+    memcpy(best, weights, weights_len * sizeof(float));
+    MLPConst view = {AMBIENT_INPUT_LEN, hidden, AMBIENT_OUTPUT_LEN, MLP_ACTIVATION_LIBM, weights};
+
+    // Separação treino / validação
+    int *indices = malloc(count * sizeof(int));
+    for (int i = 0; i < count; i++) indices[i] = i;
+    shuffle(indices, count);
+    int val_count = (int)(count * holdout);
+    int train_count = count - val_count;
+    int *val = indices + train_count;
+    if (train_count < 1) {
+        fprintf(stderr, "poucas amostras para treino\n");
+        return 1;
+    }
+
+    pthread_barrier_init(&batch_start, NULL, threads);
+    pthread_barrier_init(&batch_done, NULL, threads);
+    for (int t = 0; t < threads; t++) {
+        workers[t].work = (worker_t){.model = &view, .samples = samples, .weights_len = weights_len,
+                                     .grad = malloc(weights_len * sizeof(float))};
+        if (t > 0) pthread_create(&workers[t].thread, NULL, worker_main, &workers[t].work);
+    }
+
+    float best_val = 1e30f, best_acc = 0;
+    int best_epoch = 0, epoch;
+
+    for (epoch = 1; epoch <= epochs; epoch++) {
+        float train_error = 0;
+        shuffle(indices, train_count);
+
+        for (int start = 0; start < train_count; start += batch) {
+            int n = (train_count - start < batch) ? train_count - start : batch;
+            int per = (n + threads - 1) / threads;
+
+            for (int t = 0; t < threads; t++) {
+                int begin = t * per < n ? t * per : n;
+                int end = (t + 1) * per < n ? (t + 1) * per : n;
+                workers[t].work.indices = indices + start + begin;
+                workers[t].work.count = end - begin;
+            }
+
+            // A thread principal faz a fatia 0 entre as duas barreiras
+            pthread_barrier_wait(&batch_start);
+            work_slice(&workers[0].work);
+            pthread_barrier_wait(&batch_done);
+
+            // Redução em ordem fixa e passo de descida com o gradiente médio do lote
+            memcpy(grad, workers[0].work.grad, weights_len * sizeof(float));
+            train_error += workers[0].work.quad_error;
+            for (int t = 1; t < threads; t++) {
+                for (int k = 0; k < weights_len; k++) grad[k] += workers[t].work.grad[k];
+                train_error += workers[t].work.quad_error;
+            }
+            for (int k = 0; k < weights_len; k++) weights[k] -= lr * grad[k] / n;
+        }
+
+        float acc;
+        float val_error = val_count ? evaluate(&view, samples, val, val_count, &acc)
+                                    : evaluate(&view, samples, indices, train_count, &acc);
+        if (val_error < best_val) {
+            best_val = val_error;
+            best_acc = acc;
+            best_epoch = epoch;
+            memcpy(best, weights, weights_len * sizeof(float));
+        } else if (epoch - best_epoch >= patience) {
+            break;
+        }
+
+        if (epoch % 100 == 0) {
+            fprintf(stderr, "epoca %d: erro treino %.5f, validacao %.5f (%.2f%%)\n", epoch,
+                    train_error / train_count, val_error, 100 * acc);
+        }
+    }
+
+    workers_quit = 1;
+    pthread_barrier_wait(&batch_start);
+    for (int t = 1; t < threads; t++) pthread_join(workers[t].thread, NULL);
+
+    fprintf(stderr, "%d amostras (%d validacao); melhor epoca %d de %d: erro %.5f, acerto %.2f%%\n", count,
+            val_count, best_epoch, epoch > epochs ? epochs : epoch, best_val, 100 * best_acc);
+    if (hidden != AMBIENT_HIDDEN_LEN) {
+        fprintf(stderr, "atenção: ajuste AMBIENT_HIDDEN_LEN para %d em ambient_model.h\n", hidden);
+    }
+
+    FILE *f = out_path ? fopen(out_path, "w") : stdout;
+    if (!f) {
+        perror(out_path);
+        return 1;
+    }
+    emit_model(f, best, hidden, view.activation);
+    if (out_path) fclose(f);
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <stdio.h>
+#include "telemetry.h"
+#include "color_utils.h"
+
+// Converte o fluxo de telemetria binária (build com -DSENSORES_TELEMETRY_BINARY=ON) em CSV.
+// Uso: host/telemetry_decode [arquivo] > amostras.csv   (sem arquivo, lê a entrada padrão)
+//      host/sensores-gy33-gy302-host --duration-ms 60000 | host/telemetry_decode
+// Quadros inválidos (CRC, tamanho, texto misturado ao fluxo) são contados e descartados.
+
+int main(int argc, char **argv) {
+    FILE *in = stdin;
+    uint8_t frame[TELEMETRY_FRAME_MAX];
+    size_t len = 0;
+    bool overflow = false;
+    unsigned long good = 0, bad = 0;
+    int ch;
+
+    if (argc > 2) {
+        fprintf(stderr, "uso: %s [arquivo]\n", argv[0]);
+        return 2;
+    }
+    if (argc == 2 && !(in = fopen(argv[1], "rb"))) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    printf("timestamp_ms,c,r,g,b,lux,h_graus,s,v,cor,modo,alerta");
+    for (int i = 0; i < AMBIENT_OUTPUT_LEN; i++) printf(",mlp%d", i);
+    printf("\n");
+
+    while ((ch = fgetc(in)) != EOF) {
+        if (ch != 0) {
+            if (len < sizeof(frame)) frame[len++] = (uint8_t)ch;
+            else overflow = true;
+            continue;
+        }
+        if (len == 0) continue; // Delimitadores seguidos
+
+        sample_record_t s;
+        if (!overflow && telemetry_decode(frame, len, &s)) {
+            printf("%lu,%u,%u,%u,%u,%u,%.2f,%.4f,%u,%s,%d,%d", (unsigned long)s.timestamp_ms, s.raw_c, s.raw_r,
+                   s.raw_g, s.raw_b, s.lux, s.hsv.h / (double)(1 << HSV_H_FRAC_BITS), s.hsv.s / (double)HSV_S_ONE,
+                   s.hsv.v, obter_nome_para_cor(s.cor), s.mode, s.alert);
+            for (int i = 0; i < AMBIENT_OUTPUT_LEN; i++) printf(",%.4f", s.mlp_outputs[i] / (double)MLP_Q15_ONE);
+            printf("\n");
+            good++;
+        } else {
+            bad++;
+        }
+        len = 0;
+        overflow = false;
+    }
+    if (len) bad++; // Quadro truncado no fim do fluxo
+
+    fprintf(stderr, "%lu quadros decodificados, %lu invalidos\n", good, bad);
+    if (in != stdin) fclose(in);
+    return 0;
+}
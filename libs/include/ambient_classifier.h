@@ -0,0 +1,25 @@
+#ifndef AMBIENT_CLASSIFIER_H
+#define AMBIENT_CLASSIFIER_H
+
+#include <stdint.h>
+#include "sample_ring.h"
+#include "sensor_history.h"
+#include "runtime_config.h"
+
+// Decisão de uma amostra a partir das leituras brutas: o firmware (task_read_color) e o
+// replay do log da flash (host/tools/flash_log_replay.c) passam pelo mesmo código, então
+// uma decisão registrada em campo pode ser reproduzida bit a bit no host.
+
+// Suavização da EWMA do histórico de leituras (alfa = 1/4)
+#define AMBIENT_HISTORY_EWMA_SHIFT 2
+
+// Modo do ambiente pelo MLP de ambient_model.c (0 Relax, 1 Work, 2 Party, 3 incerto/fora da faixa
+// de lux do modo em config); outputs recebe as AMBIENT_OUTPUT_LEN saídas em Q15
+int get_ambient_mode(uint8_t r, uint8_t g, uint8_t b, uint16_t lux, const runtime_config_t* config, int16_t* outputs);
+
+// Acrescenta raw (na ordem de sensor_channel_t) ao histórico e preenche a amostra: medianas
+// da janela, HSV, cor, alertas, modo e saídas do MLP, com a calibração e os limiares de config
+void classify_sample(sensor_history_t* history, const runtime_config_t* config, uint32_t timestamp_ms,
+                     const uint16_t raw[SENSOR_CHANNELS], sample_record_t* sample);
+
+#endif // AMBIENT_CLASSIFIER_H
@@ -0,0 +1,16 @@
+#ifndef AMBIENT_MODEL_H
+#define AMBIENT_MODEL_H
+
+#include "mlp.h"
+
+// Modelo treinado que classifica o modo do ambiente (Idle, Work, Fest) a partir da cor
+#define AMBIENT_INPUT_LEN 3
+#define AMBIENT_HIDDEN_LEN 5
+#define AMBIENT_OUTPUT_LEN 3
+
+extern const MLPConst ambient_model;
+
+// Versão int8/Q15 do mesmo modelo, gerada por host/tools/mlp_quantize.c (ambient_model_q8.c)
+extern const MLPQ8 ambient_model_q8;
+
+#endif // AMBIENT_MODEL_H
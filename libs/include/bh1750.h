@@ -5,10 +5,25 @@
 #include "hardware/i2c.h"
 #include "hardware/gpio.h"
 
+#define BH1750_HRES_MEAS_TIME_MS 180 // Tempo máximo de conversão no modo de alta resolução
+
 void _i2c_write_byte(i2c_inst_t* i2c, uint8_t byte); 
 
 void bh1750_power_on(i2c_inst_t* i2c);
 
 uint16_t bh1750_read_measurement(i2c_inst_t* i2c);
 
+// Estado do modo contínuo: o sensor converte sozinho e o driver só lê quando há conversão nova
+typedef struct {
+    i2c_inst_t* i2c;
+    absolute_time_t next_conversion; // Instante em que a próxima conversão estará pronta
+    uint16_t lux;                    // Última medida lida
+} bh1750_t;
+
+void bh1750_start_continuous(bh1750_t* dev, i2c_inst_t* i2c);
+
+bool bh1750_data_ready(bh1750_t* dev);
+
+bool bh1750_try_read(bh1750_t* dev, uint16_t* lux);
+
 #endif
\ No newline at end of file
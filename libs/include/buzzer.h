@@ -0,0 +1,27 @@
+#ifndef BUZZER_H
+#define BUZZER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+
+// Sequenciador de tons do buzzer: um padrão é uma tabela de passos (nível PWM, duração)
+// tocada em segundo plano por um alarme, sem bloquear quem chamou.
+typedef struct {
+    uint16_t level;       // Nível PWM (0 = silêncio, 255 = máximo)
+    uint16_t duration_ms;
+} tone_step_t;
+
+typedef struct {
+    const tone_step_t *steps;
+    uint count;
+} tone_pattern_t;
+
+#define BUZZER_QUEUE_SIZE 4 // Padrões aguardando o atual terminar
+
+void buzzer_init(uint pin);
+bool buzzer_play(const tone_pattern_t* pattern);
+void buzzer_cancel(void);
+bool buzzer_busy(void);
+
+#endif // BUZZER_H
@@ -16,12 +16,55 @@ typedef struct {
     uint8_t b;
 } CorRGB;
 
+// HSV em ponto fixo, sem ponto flutuante (o RP2040 não tem FPU)
+typedef struct {
+    uint16_t h; // Hue em graus no formato Q6 (0 a 360*64 - 1)
+    uint16_t s; // Saturação em Q15 (0 a 32768 = 1.0), apenas para exibição
+    uint8_t v;  // Value escalado para 0 a 255 (v * 255), igual ao maior componente
+    uint8_t c;  // Croma (maior - menor componente), usado nas comparações exatas de saturação
+    uint8_t empates; // HSV_EMPATE_*: lado em que a versão em float cai num empate exato
+} CorHSV;
+
+#define HSV_H_FRAC_BITS 6
+#define HSV_EMPATE_H_ABAIXO 0x01 // Hue exato num grau inteiro; em float, logo abaixo dele
+#define HSV_EMPATE_S_ABAIXO 0x02 // Saturação exata no limiar; em float, abaixo dele
+#define HSV_S_ONE 32768
+
+// Limiares da identificação em ponto fixo (configuráveis em campo, runtime_config.h).
+// Saturação e brilho em porcentagem; a cor de cada grau inteiro de Hue vem de uma tabela.
+typedef struct __attribute__((packed)) {
+    uint8_t v_min;         // V abaixo disto: INDEFINIDO
+    uint8_t branco_s_max;  // S abaixo disto e V acima de branco_v_min: BRANCO
+    uint8_t branco_v_min;
+    uint8_t intensa_s_min; // Cor intensa (alerta de vermelho intenso): S e V acima destes
+    uint8_t intensa_v_min;
+    uint8_t cor_por_grau[360]; // CorIdentificada de cada grau de Hue
+} LimiaresCor;
+
+// Mesmos limiares de identificar_cor_hsv(); a macro também inicializa a configuração padrão
+#define LIMIARES_COR_PADRAO {                                                                    \
+    .v_min = 20,                                                                                 \
+    .branco_s_max = 25,                                                                          \
+    .branco_v_min = 90,                                                                          \
+    .intensa_s_min = 60,                                                                         \
+    .intensa_v_min = 70,                                                                         \
+    .cor_por_grau = {                                                                            \
+        [0 ... 14] = VERMELHO, [40 ... 74] = AMARELO, [75 ... 164] = VERDE, [165 ... 194] = CIANO, \
+        [195 ... 254] = AZUL, [285 ... 344] = MAGENTA, [345 ... 359] = VERMELHO,                 \
+    },                                                                                           \
+}
+
+extern const LimiaresCor limiares_cor_padrao;
+
 
 // --- Protótipos das Funções ---
 
 uint8_t map(long x, long in_min, long in_max, long out_min, long out_max);
 void RGBtoHSV(float r, float g, float b, float *h, float *s, float *v);
 CorIdentificada identificar_cor_hsv(float h, float s, float v);
+void RGBtoHSV_fixed(uint8_t r, uint8_t g, uint8_t b, CorHSV *hsv);
+CorIdentificada identificar_cor_hsv_fixed(const CorHSV *hsv, const LimiaresCor *lim);
+int cor_hsv_intensa(const CorHSV *hsv, const LimiaresCor *lim);
 CorRGB obter_rgb_para_cor(CorIdentificada cor);
 const char* obter_nome_para_cor(CorIdentificada cor);
 
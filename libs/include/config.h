@@ -15,18 +15,43 @@
 // --- Configurações do Sensor de Cor ---
 #define GY33_I2C_ADDR   0x29
 #define GY33_COMMAND_BIT 0x80
+#define GY33_AUTO_INCREMENT 0x20 // Tipo de transação com auto-incremento do endereço
 #define ENABLE_REG      0x00
 #define ATIME_REG       0x01
 #define CONTROL_REG     0x0F
+#define STATUS_REG      0x13
 #define CDATA_REG       0x14
 #define RDATA_REG       0x16
 #define GDATA_REG       0x18
 #define BDATA_REG       0x1A
 
 // --- Limiares e Configurações de Lógica ---
+// Valores padrão: os valores em uso vêm da configuração gravada na flash (runtime_config.h),
+// ajustável pela USB sem recompilar
 #define LUMINOSITY_THRESHOLD 10 // Limite de luminosidade para alerta [ATENÇÃO: Insira o valor mínimo que o sensor consegue ler no seu ambiente]
 #define LUMINOSITY_MAX 300 // Limite máximo de luminosidade para ajuste de brilho [ATENÇÃO: Insira o valor máximo que o sensor consegue ler no seu ambiente com luz intensa]
 #define SENSOR_COLOR_MAX_VALUE 4095 // Valor para normalização dos dados brutos
+#define RELAX_LUX_MIN 10 // Faixas de lux que confirmam o modo do ambiente indicado pelo MLP
+#define RELAX_LUX_MAX 300
+#define WORK_LUX_MIN 300
+#define WORK_LUX_MAX 700
+#define PARTY_LUX_MIN 700
+#define PARTY_LUX_MAX 1000
+
+// --- Telemetria ---
+#ifndef TELEMETRY_BINARY
+#define TELEMETRY_BINARY 0 // 1: cada amostra vai para a USB como quadro binário (telemetry.h) e o log em texto é desligado
+#endif
+
+// --- Perfil de desempenho ---
+#ifndef PROFILE_ENABLED
+#define PROFILE_ENABLED 0 // 1: mede as etapas do laço (profile.h); 'p' no stdio imprime, 'r' zera
+#endif
+
+// --- Mapa da flash (fim da flash, longe da imagem do programa) ---
+#define FLASH_CONFIG_OFFSET (PICO_FLASH_SIZE_BYTES - 2 * FLASH_SECTOR_SIZE) // Dois setores da configuração (runtime_config.h)
+#define FLASH_LOG_SECTORS 32 // 128 KB de log circular de amostras (flash_log.h)
+#define FLASH_LOG_OFFSET (FLASH_CONFIG_OFFSET - FLASH_LOG_SECTORS * FLASH_SECTOR_SIZE)
 
 // --- Pinos do LED RGB e Botões ---
 #define LED_RED 13
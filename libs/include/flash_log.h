@@ -0,0 +1,71 @@
+#ifndef FLASH_LOG_H
+#define FLASH_LOG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "sample_ring.h"
+#include "sensor_history.h"
+
+// Log circular de amostras na flash (FLASH_LOG_SECTORS setores a partir de FLASH_LOG_OFFSET,
+// em config.h), para reproduzir no host as decisões tomadas em campo.
+//
+// As amostras se acumulam em uma página na RAM e cada página cheia é gravada uma única vez.
+// O log avança setor a setor e só apaga um setor quando a escrita entra nele, então todos
+// os setores são apagados o mesmo número de vezes. Com ~8 bytes por amostra (medido em
+// host/test/flash_log_test.c) uma página guarda ~32 amostras e a região ~16 mil. Na exposição
+// de referência (~10 amostras/s) uma página dura ~3 s, o log guarda ~27 min e cada setor é
+// apagado uma vez por volta, a cada ~27 min (~5 anos contínuos até os 100 mil ciclos típicos
+// da flash); com luz forte a integração do GY-33 encurta e esses tempos caem até ~4x.
+//
+// Página (FLASH_PAGE_SIZE bytes):
+//   0 u16 magic   2 u8 versão   3 u8 bytes de registros   4 u32 sequência   8 u16 CRC-16
+//   10.. registros; o CRC cobre os bytes 0..7 e os registros
+// Registro, com deltas em relação ao anterior da mesma página (o primeiro, em relação a zero,
+// para cada página ser decodificável sozinha):
+//   u8 flags: bits 0-3 cor, 4-5 modo, 6 alerta, 7 primeira amostra desde o boot
+//   varint delta do timestamp_ms; varint zigzag dos deltas de cada canal de sensor_channel_t
+#define FLASH_LOG_MAGIC 0x4C47
+#define FLASH_LOG_VERSION 1
+#define FLASH_LOG_HEADER_LEN 10
+#define FLASH_LOG_RECORD_MAX_LEN (1 + 5 + 3 * SENSOR_CHANNELS)
+
+// Entrada do log: leituras (as do GY-33 normalizadas à exposição de referência) e decisões
+typedef struct {
+    uint32_t timestamp_ms;
+    uint16_t raw[SENSOR_CHANNELS];
+    uint8_t cor;
+    int8_t mode;
+    bool alert;
+    bool boot;
+} flash_log_entry_t;
+
+// Gravações que falharam (flash_safe_execute sem sucesso) e amostras descartadas enquanto a
+// página cheia esperava uma nova tentativa, desde o boot
+typedef struct {
+    uint32_t failed_writes;
+    uint32_t dropped_samples;
+} flash_log_stats_t;
+
+// Núcleo que grava o log; localiza a página mais recente pelo número de sequência
+void flash_log_init(void);
+void flash_log_append(const sample_record_t* sample);
+flash_log_stats_t flash_log_stats(void);
+
+// Envia o log, da página mais antiga à mais recente (incluindo a página ainda na RAM), como
+// quadros COBS terminados em 0x00, um por página, precedidos de um 0x00 de sincronismo
+void flash_log_dump(int (*put)(int c));
+
+// Leitura das páginas (host/tools/flash_log_replay.c)
+bool flash_log_page_valid(const uint8_t* page, size_t len, uint32_t* seq);
+
+typedef struct {
+    const uint8_t* next;
+    const uint8_t* end;
+    flash_log_entry_t prev;
+} flash_log_cursor_t;
+
+void flash_log_cursor_init(flash_log_cursor_t* cursor, const uint8_t* page);
+bool flash_log_cursor_next(flash_log_cursor_t* cursor, flash_log_entry_t* entry);
+
+#endif // FLASH_LOG_H
@@ -2,10 +2,33 @@
 #define GY33_H
 
 #include <stdint.h>
+#include <stdbool.h>
+
+// Amostra dos quatro canais vindos de um mesmo ciclo de integração
+typedef struct {
+    uint16_t c;
+    uint16_t r;
+    uint16_t g;
+    uint16_t b;
+} gy33_color_t;
+
+#define GY33_ATIME_CYCLE_US 2400
+#define GY33_RESTART_US (2 * GY33_ATIME_CYCLE_US) // Ciclo de partida do sensor depois do AEN, mais folga
+
+// Exposição de referência (ganho x ciclos de integração): 16x e 43 ciclos, a configuração
+// fixa anterior. gy33_normalize leva as leituras para esta escala, em que os limiares e a
+// calibração (SENSOR_COLOR_MAX_VALUE) foram ajustados.
+#define GY33_REFERENCE_EXPOSURE (16 * 43)
+
 // Declaração das funções do módulo GY-33
 
 void gy33_init();
-void gy33_read_color(uint16_t *r, uint16_t *g, uint16_t *b, uint16_t *c);
+bool gy33_read_color(uint16_t *r, uint16_t *g, uint16_t *b, uint16_t *c);
+bool gy33_read_color_burst(gy33_color_t *color);
 void gy33_write_register(uint8_t reg, uint8_t value);
 uint16_t gy33_read_register(uint8_t reg);
+uint32_t gy33_integration_time_us();
+uint32_t gy33_exposure();
+bool gy33_auto_exposure(uint16_t clear);
+void gy33_normalize(gy33_color_t *color);
 #endif // GY33_H
\ No newline at end of file
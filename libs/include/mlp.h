@@ -1,14 +1,26 @@
 #ifndef MLP_H
 #define MLP_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// Implementação das funções de ativação, escolhida ao montar o modelo. As aproximações
+// evitam expf/tanhf (caros no RP2040, sem FPU); erro máximo contra a libm:
+// LUT ~1.2e-5 na sigmoid e ~2.4e-5 na tanh, PWL ~1.9e-2 na sigmoid e ~3.8e-2 na tanh
+typedef enum {
+    MLP_ACTIVATION_LIBM = 0, // expf/tanhf
+    MLP_ACTIVATION_PWL,      // Linear por partes (PLAN), só somas e multiplicações
+    MLP_ACTIVATION_LUT,      // Tabela de 0 a 16 com passo 1/32 e interpolação linear
+} MLPActivation;
+
 typedef struct {
     int input_layer_length;
     int hidden_layer_length;
     int output_layer_length;
+    MLPActivation activation;
     int max_epochs;
     float learning_rate;
     float threshold;
@@ -18,10 +30,57 @@ typedef struct {
     float *output_layer_outputs;
 } MLP;
 
+// Modelo somente leitura: pesos e bias em um único array contíguo e constante (fica na
+// flash/XIP), linha a linha com o bias no fim de cada linha:
+// [hidden_layer_length][input_layer_length + 1] seguido de [output_layer_length][hidden_layer_length + 1]
+typedef struct {
+    int input_layer_length;
+    int hidden_layer_length;
+    int output_layer_length;
+    MLPActivation activation;
+    const float *weights;
+} MLPConst;
+
+#define MLP_CONST_WEIGHTS_LEN(in, hidden, out) ((hidden) * ((in) + 1) + (out) * ((hidden) + 1))
+
+// Modelo quantizado: pesos int8 com uma escala por camada, ativações Q15 (32768 = 1; em int16_t
+// vão até MLP_Q15_MAX)
+// e acumulação inteira. Os bias ficam em int32 já na escala do acumulador da camada.
+// weights: [hidden_layer_length][input_layer_length] seguido de [output_layer_length][hidden_layer_length]
+// biases: [hidden_layer_length] seguido de [output_layer_length]
+typedef struct {
+    int32_t multiplier; // net Q12 = (acumulador * multiplier) >> shift
+    int shift;
+} MLPQ8Scale;
+
+typedef struct {
+    int input_layer_length;
+    int hidden_layer_length;
+    int output_layer_length;
+    const int8_t *weights;
+    const int32_t *biases;
+    MLPQ8Scale hidden_scale;
+    MLPQ8Scale output_scale;
+} MLPQ8;
+
+#define MLP_Q8_WEIGHTS_LEN(in, hidden, out) ((hidden) * (in) + (out) * (hidden))
+#define MLP_Q8_BIASES_LEN(in, hidden, out) ((hidden) + (out))
+#define MLP_Q15_ONE 32768 // 1,0 em Q15, mesma escala de HSV_S_ONE
+#define MLP_Q15_MAX 32767 // Maior valor representável em int16_t
+
+// Entrada 0..255 para Q15 (0..1), saturada em MLP_Q15_MAX
+#define MLP_Q15_FROM_U8(x) ((int16_t)((x) == 255 ? MLP_Q15_MAX : ((x) * MLP_Q15_ONE + 127) / 255))
+
 // Funções de ativação
 float identity(float z);
 float sigmoid(float z);
 float tanhyper(float z);
+float sigmoid_pwl(float z);
+float tanh_pwl(float z);
+float sigmoid_lut(float z);
+float tanh_lut(float z);
+float mlp_sigmoid(MLPActivation activation, float z);
+float mlp_tanh(MLPActivation activation, float z);
 
 // Derivadas
 float d_identity(float z);
@@ -29,9 +88,29 @@ float d_sigmoid(float z);
 float d_tanhyper(float z);
 
 // Funções principais
-void model(MLP* mlp, int input_layer_length, int hidden_layer_length, int output_layer_length, int max_epochs, float learning_rate, float threshold);
+void model(MLP* mlp, int input_layer_length, int hidden_layer_length, int output_layer_length, MLPActivation activation, int max_epochs, float learning_rate, float threshold);
 void forward(MLP* mlp, float* X);
 void backpropagation(MLP* mlp, float** X, float** Y, int samples);
+void init_weights(MLP* mlp, unsigned int seed);
+
+// Treino em lote: pesos e gradientes no layout contíguo de MLPConst.weights
+// (MLP_CONST_WEIGHTS_LEN floats). accumulate_gradients soma em grad o gradiente do erro
+// quadrático de uma amostra e devolve esse erro; só lê o modelo, então várias threads podem
+// acumular em buffers próprios ao mesmo tempo.
+void export_weights(const MLP* mlp, float* weights);
+void import_weights(MLP* mlp, const float* weights);
+float accumulate_gradients(const MLPConst* mlp, const float* X, const float* Y, float* grad, float* hidden_layer_outputs, float* output_layer_outputs);
+void forward_const(const MLPConst* mlp, const float* X, float* hidden_layer_outputs, float* output_layer_outputs);
+// Inferência em lote com entrada em estrutura de arrays: X[input_layer_length][samples],
+// hidden_layer_outputs[hidden_layer_length][samples] (rascunho) e
+// output_layer_outputs[output_layer_length][samples]. O laço interno percorre as amostras,
+// então o compilador vetoriza o produto matriz-vetor; o resultado é idêntico ao de forward_const.
+void forward_batch(const MLPConst* mlp, const float* X, float* hidden_layer_outputs, float* output_layer_outputs, int samples);
+void forward_q8(const MLPQ8* mlp, const int16_t* X, int16_t* hidden_layer_outputs, int16_t* output_layer_outputs);
+
+// Converte um modelo float para int8/Q15; weights e biases são os buffers de saída
+// (tamanhos MLP_Q8_WEIGHTS_LEN e MLP_Q8_BIASES_LEN)
+void quantize_mlp(const MLPConst* src, MLPQ8* dst, int8_t* weights, int32_t* biases);
 
 #ifdef __cplusplus
 }
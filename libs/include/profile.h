@@ -0,0 +1,60 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+#include "config.h"
+
+// Perfil por etapa: tempo de cada execução em ns, com contagem, total, máximo e um
+// histograma log2 (balde i: [2^i, 2^(i+1)) ns). No RP2040 a base é o timer de 1 us; no
+// host, clock_gettime, que mede só o custo de CPU (o barramento I2C simulado não gasta
+// tempo real). Com PROFILE_ENABLED = 0 as macros somem e nada é compilado.
+//
+//     PROFILE_SCOPE(PROFILE_GY33_READ) {
+//         valid = gy33_read_color_burst(&color);
+//     }
+//
+// Um return ou break dentro do bloco pula o registro da execução.
+// Cada etapa deve ser medida em um só núcleo; o dump lê os contadores sem trava.
+// No firmware, 'p' no stdio imprime o perfil e 'r' o zera (console_poll em main.c).
+
+typedef enum {
+    PROFILE_BH1750_READ,
+    PROFILE_GY33_READ,
+    PROFILE_HSV,
+    PROFILE_MLP,
+    PROFILE_OLED_DRAW,
+    PROFILE_OLED_SEND,
+    PROFILE_LEDS,
+    PROFILE_STAGES
+} profile_stage_id_t;
+
+#define PROFILE_BUCKETS 32
+
+typedef struct {
+    uint32_t count;
+    uint32_t max_ns;
+    uint64_t total_ns;
+    uint32_t buckets[PROFILE_BUCKETS];
+} profile_stage_t;
+
+#if PROFILE_ENABLED
+
+uint32_t profile_now_ns(void);
+void profile_record(profile_stage_id_t stage, uint32_t elapsed_ns);
+void profile_reset(void);
+void profile_dump(void);
+const profile_stage_t* profile_stage(profile_stage_id_t stage);
+
+#define PROFILE_SCOPE(stage) \
+    for (uint32_t profile_t0_ = profile_now_ns(), profile_once_ = 1; profile_once_; \
+         profile_once_ = 0, profile_record((stage), profile_now_ns() - profile_t0_))
+
+#else
+
+#define PROFILE_SCOPE(stage)
+#define profile_reset() ((void)0)
+#define profile_dump() ((void)0)
+
+#endif // PROFILE_ENABLED
+
+#endif // PROFILE_H
@@ -0,0 +1,63 @@
+#ifndef RUNTIME_CONFIG_H
+#define RUNTIME_CONFIG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ambient_model.h"
+#include "color_utils.h"
+
+// Calibração e limiares ajustáveis em campo, gravados na flash (FLASH_CONFIG_OFFSET, em
+// config.h) e carregados uma vez no boot; os valores de config.h e limiares_cor_padrao são
+// os padrões quando não há configuração válida na flash.
+//
+// Dois setores alternados: cada gravação vai para o setor que não tem a configuração atual,
+// com sequência maior. Se a energia cair no meio da gravação, o outro setor continua com a
+// configuração anterior, válida; no boot vale a válida de maior sequência.
+//
+// Registro, no início do setor:
+//   0 u16 magic   2 u8 versão   3 u8 reservado   4 u16 tamanho da configuração
+//   6 u32 sequência   10 u16 CRC-16 dos bytes 0..9 e da configuração   12.. runtime_config_t
+#define RUNTIME_CONFIG_MAGIC 0x4346
+#define RUNTIME_CONFIG_VERSION 1
+#define RUNTIME_CONFIG_HEADER_LEN 12
+#define RUNTIME_CONFIG_RECORD_LEN (RUNTIME_CONFIG_HEADER_LEN + sizeof(runtime_config_t))
+
+// Lida diretamente pelo caminho quente, sem conversão por amostra. O aligned(4) mantém os
+// campos de 16 bits alinhados: com só packed, o Cortex-M0+ os leria byte a byte.
+typedef struct __attribute__((packed, aligned(4))) {
+    uint16_t luminosity_threshold; // Alerta de baixa luminosidade abaixo disto
+    uint16_t luminosity_max;       // Lux do brilho máximo dos LEDs
+    uint16_t color_max_value;      // Leitura bruta que vira 255 na normalização
+    uint16_t mode_lux[AMBIENT_OUTPUT_LEN][2]; // Faixa de lux (mín., máx.) que confirma cada modo
+    LimiaresCor cor;
+} runtime_config_t;
+
+// Configuração em uso pelo núcleo 0 (classify_sample). Só muda em runtime_config_sync(); o
+// núcleo 1 não a lê: o que ele precisa (limites do brilho dos LEDs) vem em cada amostra.
+extern runtime_config_t runtime_config;
+extern const runtime_config_t runtime_config_default;
+
+// Boot: carrega a configuração válida mais recente da flash (false: ficou a padrão)
+bool runtime_config_load(void);
+
+// Grava no setor alternado; false se a configuração for inválida ou a gravação falhar.
+// Pausa o outro núcleo durante o apagamento do setor (~45 ms).
+bool runtime_config_save(const runtime_config_t *config);
+
+bool runtime_config_valid(const runtime_config_t *config);
+
+// Confere e decodifica um registro (da flash ou do dump); seq pode ser NULL
+bool runtime_config_decode(const uint8_t *record, size_t len, runtime_config_t *config, uint32_t *seq);
+
+// Envia a configuração em uso como um quadro COBS (lido por host/tools/flash_log_replay)
+void runtime_config_dump(int (*put)(int c));
+
+// Núcleo 1: executa uma linha "cfg ..." do console (cfg help lista os comandos).
+// As alterações valem depois de "cfg apply" (só na RAM) ou "cfg save".
+bool runtime_config_command(const char *line);
+
+// Núcleo 0: adota a configuração publicada por runtime_config_command, se houver
+void runtime_config_sync(void);
+
+#endif // RUNTIME_CONFIG_H
@@ -0,0 +1,44 @@
+#ifndef SAMPLE_RING_H
+#define SAMPLE_RING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "color_utils.h"
+#include "ambient_model.h"
+
+// Amostra produzida pelo núcleo 0 (leitura dos sensores, HSV e MLP) e consumida pelo
+// núcleo 1 (display, matriz de LEDs, LED RGB, buzzer e log USB)
+typedef struct {
+    uint32_t timestamp_ms;
+    uint16_t lux;         // Mediana da janela do histórico
+    uint16_t raw_lux;     // Leitura bruta do BH1750
+    uint16_t raw_c, raw_r, raw_g, raw_b; // Leituras do GY-33 normalizadas à exposição de referência
+    uint8_t r, g, b;      // Cor normalizada para 0..255
+    CorHSV hsv;
+    CorIdentificada cor;
+    int8_t mode;          // Modo do ambiente (0 Relax, 1 Work, 2 Party, 3 incerto)
+    int16_t mlp_outputs[AMBIENT_OUTPUT_LEN]; // Saídas do MLP em Q15 (MLP_Q15_ONE = 1)
+    bool alert;           // Baixa luminosidade ou vermelho intenso
+    uint16_t lux_min, lux_max; // Faixa de lux do brilho dos LEDs (da configuração em uso no núcleo 0)
+} sample_record_t;
+
+// Fila lock-free de um produtor e um consumidor, um em cada núcleo. head só é escrito pelo
+// produtor e tail só pelo consumidor; os índices crescem livremente e o slot é índice % tamanho.
+#define SAMPLE_RING_SIZE 8 // Potência de 2
+
+typedef struct {
+    sample_record_t slots[SAMPLE_RING_SIZE];
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    volatile uint32_t dropped; // Amostras descartadas com a fila cheia
+} sample_ring_t;
+
+void sample_ring_init(sample_ring_t* ring);
+
+// Produtor: nunca bloqueia; com a fila cheia a amostra é descartada e contada em dropped
+bool sample_ring_push(sample_ring_t* ring, const sample_record_t* sample);
+
+// Consumidor: copia a amostra mais antiga; false se a fila estiver vazia
+bool sample_ring_pop(sample_ring_t* ring, sample_record_t* sample);
+
+#endif // SAMPLE_RING_H
@@ -0,0 +1,23 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "pico/stdlib.h"
+
+// Escalonador cooperativo por prazos: cada tarefa roda quando seu prazo vence e o
+// próximo prazo é o anterior + período (sem deriva). Entre tarefas o núcleo dorme em
+// __wfe até o prazo mais próximo ou até um evento.
+typedef struct {
+    const char *name;
+    uint32_t period_us;             // Pode ser alterado pela própria tarefa
+    void (*run)(void);
+    absolute_time_t next_deadline;
+    uint32_t runs;
+    uint32_t overruns;              // Execuções que atrasaram além do prazo seguinte
+} task_t;
+
+void scheduler_start(task_t* tasks, uint count);
+void scheduler_run_pending(task_t* tasks, uint count);
+absolute_time_t scheduler_next_deadline(const task_t* tasks, uint count);
+void scheduler_idle(const task_t* tasks, uint count);
+
+#endif // SCHEDULER_H
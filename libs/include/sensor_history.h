@@ -0,0 +1,52 @@
+#ifndef SENSOR_HISTORY_H
+#define SENSOR_HISTORY_H
+
+#include <stdint.h>
+#include "pico/types.h"
+
+// Histórico das últimas SENSOR_HISTORY_LEN leituras com estatísticas incrementais por
+// canal, atualizadas a cada push sem reler o histórico e sem alocação:
+// - média da janela: soma corrente, O(1)
+// - EWMA: alfa = 1 / 2^ewma_shift, em Q8, O(1)
+// - mínimo e máximo da janela: filas monotônicas, O(1) amortizado
+// - mediana da janela: janela ordenada, busca binária e deslocamento de até LEN valores
+#define SENSOR_HISTORY_LEN 8 // Potência de 2
+
+typedef enum {
+    SENSOR_LUX, SENSOR_RED, SENSOR_GREEN, SENSOR_BLUE, SENSOR_CLEAR, SENSOR_CHANNELS
+} sensor_channel_t;
+
+typedef struct {
+    uint32_t timestamp_ms;
+    uint16_t value[SENSOR_CHANNELS];
+} sensor_sample_t;
+
+typedef struct {
+    uint32_t sum;
+    uint32_t ewma_q8;
+    uint16_t sorted[SENSOR_HISTORY_LEN];
+    uint32_t min_queue[SENSOR_HISTORY_LEN]; // Números de sequência, valores crescentes
+    uint32_t max_queue[SENSOR_HISTORY_LEN]; // Números de sequência, valores decrescentes
+    uint8_t min_head, min_count;
+    uint8_t max_head, max_count;
+} sensor_channel_stats_t;
+
+typedef struct {
+    sensor_sample_t samples[SENSOR_HISTORY_LEN];
+    uint32_t pushed; // Total de amostras recebidas (sequência da próxima)
+    uint8_t ewma_shift;
+    sensor_channel_stats_t channel[SENSOR_CHANNELS];
+} sensor_history_t;
+
+void sensor_history_init(sensor_history_t* h, uint8_t ewma_shift);
+void sensor_history_push(sensor_history_t* h, uint32_t timestamp_ms, const uint16_t value[SENSOR_CHANNELS]);
+uint sensor_history_size(const sensor_history_t* h);
+const sensor_sample_t* sensor_history_get(const sensor_history_t* h, uint age); // 0 = mais recente
+
+uint16_t sensor_history_mean(const sensor_history_t* h, sensor_channel_t ch);
+uint16_t sensor_history_ewma(const sensor_history_t* h, sensor_channel_t ch);
+uint16_t sensor_history_min(const sensor_history_t* h, sensor_channel_t ch);
+uint16_t sensor_history_max(const sensor_history_t* h, sensor_channel_t ch);
+uint16_t sensor_history_median(const sensor_history_t* h, sensor_channel_t ch);
+
+#endif // SENSOR_HISTORY_H
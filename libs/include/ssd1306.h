@@ -4,6 +4,8 @@
 
 #define WIDTH 128
 #define HEIGHT 64
+#define SSD1306_MAX_PAGES (HEIGHT / 8)
+#define SSD1306_MAX_COMMAND_LIST 32 // Comandos por transação em ssd1306_command_list
 
 typedef enum {
   SET_CONTRAST = 0x81,
@@ -25,21 +27,38 @@ typedef enum {
   SET_CHARGE_PUMP = 0x8D
 } ssd1306_command_t;
 
-typedef struct {
+typedef struct ssd1306 ssd1306_t;
+
+typedef void (*ssd1306_flush_callback_t)(ssd1306_t *ssd);
+
+struct ssd1306 {
   uint8_t width, height, pages, address;
   i2c_inst_t *i2c_port;
   bool external_vcc;
   uint8_t *ram_buffer;
   size_t bufsize;
   uint8_t port_buffer[2];
-} ssd1306_t;
+  // Atualização parcial: faixa de colunas alterada em cada página e cópia do que o display já mostra
+  uint8_t dirty_min[SSD1306_MAX_PAGES], dirty_max[SSD1306_MAX_PAGES];
+  uint8_t *shadow;
+  bool shadow_valid;
+  // Envio assíncrono: cópia do quadro no formato do data_cmd, alimentada por DMA
+  int dma_channel;
+  uint16_t *dma_buffer;
+  ssd1306_flush_callback_t flush_callback;
+};
 
 // === Protótipos de Funções ===
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, size_t len);
 void ssd1306_send_data(ssd1306_t *ssd);
+void ssd1306_send_data_async(ssd1306_t *ssd);
+bool ssd1306_flush_busy(ssd1306_t *ssd);
+void ssd1306_flush_wait(ssd1306_t *ssd);
+void ssd1306_set_flush_callback(ssd1306_t *ssd, ssd1306_flush_callback_t callback);
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
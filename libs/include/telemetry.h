@@ -0,0 +1,50 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "sample_ring.h"
+
+// Telemetria binária: cada amostra vira um registro de layout fixo (little-endian),
+// seguido de CRC-16/CCITT e codificado em COBS, terminado por 0x00. O 0x00 nunca aparece
+// dentro do quadro, então o decodificador se ressincroniza no próximo delimitador.
+//
+// Registro (versão 1, TELEMETRY_RECORD_LEN bytes):
+//   0  u8   versão (TELEMETRY_VERSION)
+//   1  u32  timestamp_ms
+//   5  u16  c, r, g, b do GY-33, normalizados à exposição de referência (gy33_normalize)
+//   13 u16  lux
+//   15 u16  h (graus em Q6)
+//   17 u16  s (Q15)
+//   19 u8   v (0..255)
+//   20 u8   cor (CorIdentificada)
+//   21 i8   modo do ambiente
+//   22 u8   flags (bit 0: alerta)
+//   23 i16  saídas do MLP em Q15 (AMBIENT_OUTPUT_LEN valores)
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_RECORD_LEN (23 + 2 * AMBIENT_OUTPUT_LEN)
+#define TELEMETRY_CRC_LEN 2
+#define TELEMETRY_FLAG_ALERT 0x01
+
+// COBS acrescenta 1 byte a cada 254 de dados (e no mínimo 1); mais o delimitador
+#define COBS_MAX_ENCODED_LEN(len) ((len) + (len) / 254 + 1)
+#define TELEMETRY_FRAME_MAX (COBS_MAX_ENCODED_LEN(TELEMETRY_RECORD_LEN + TELEMETRY_CRC_LEN) + 1)
+
+uint16_t telemetry_crc16(const uint8_t* data, size_t len);
+
+// Retornam o tamanho escrito em out; cobs_decode retorna 0 se a entrada for inválida
+size_t cobs_encode(const uint8_t* in, size_t len, uint8_t* out);
+size_t cobs_decode(const uint8_t* in, size_t len, uint8_t* out, size_t out_max);
+
+// Quadro completo, com o 0x00 final; retorna o tamanho (até TELEMETRY_FRAME_MAX)
+size_t telemetry_encode(const sample_record_t* sample, uint8_t* frame);
+
+// Quadro sem o 0x00 final; false se o COBS, o tamanho, o CRC ou a versão não baterem.
+// Os campos normalizados r/g/b do sample_record_t não vão no fio e ficam zerados.
+bool telemetry_decode(const uint8_t* frame, size_t len, sample_record_t* sample);
+
+// Envia pela USB CDC sem bloquear quando não há host conectado; false se descartou
+bool telemetry_send(const sample_record_t* sample);
+
+#endif // TELEMETRY_H
@@ -0,0 +1,22 @@
+#ifndef TEXT_FORMAT_H
+#define TEXT_FORMAT_H
+
+#include <stdint.h>
+
+// Formatação de texto sem printf e sem ponto flutuante, para o display OLED. Cada função
+// escreve no buffer do chamador, termina com '\0' e retorna o ponteiro para o '\0', de modo
+// que as chamadas se encadeiam:
+//     char buf[16];
+//     fmt_uint(fmt_str(buf, "H:"), h, 3);  // igual a sprintf(buf, "H:%3u", h)
+// O buffer precisa comportar o texto: até 11 caracteres por número, mais as casas decimais.
+
+char* fmt_str(char* out, const char* s);
+
+// Inteiro alinhado à direita com espaços até width caracteres (%*u / %*d)
+char* fmt_uint(char* out, uint32_t value, uint8_t width);
+char* fmt_int(char* out, int32_t value, uint8_t width);
+
+// num / den com decimals casas (%.*f), arredondado como o printf: empate vai para o par
+char* fmt_decimal(char* out, int32_t num, uint32_t den, uint8_t decimals);
+
+#endif // TEXT_FORMAT_H
@@ -0,0 +1,112 @@
+#include "ambient_classifier.h"
+#include "ambient_model.h"
+#include "color_utils.h"
+#include "profile.h"
+
+/**
+ * @brief Classifica o modo do ambiente com o MLP e confere a faixa de lux.
+ * Usa o modelo float (ambient_model): o int8 (ambient_model_q8) concorda em ~99,1% do cubo
+ * RGB, e as divergências mudariam decisões; ver host/test/mlp_q8_test.c.
+ * @param r Vermelho normalizado (0..255).
+ * @param g Verde normalizado (0..255).
+ * @param b Azul normalizado (0..255).
+ * @param lux Luminosidade.
+ * @param config Faixas de lux de cada modo.
+ * @param outputs Saídas do MLP em Q15 (AMBIENT_OUTPUT_LEN valores).
+ * @return 0 Relax, 1 Work, 2 Party ou 3 (incerto ou lux fora da faixa do modo).
+ */
+int get_ambient_mode(uint8_t r, uint8_t g, uint8_t b, uint16_t lux, const runtime_config_t* config, int16_t* outputs) {
+    float hidden[AMBIENT_HIDDEN_LEN];
+    float o[AMBIENT_OUTPUT_LEN];
+
+    // Normalização 0..255 -> 0..1
+    float X[AMBIENT_INPUT_LEN] = {r / 255.0f, g / 255.0f, b / 255.0f};
+
+    // Forward MLP (pesos constantes na flash, em ambient_model.c)
+    forward_const(&ambient_model, X, hidden, o);
+
+    // Saídas em Q15 para a amostra (telemetria e log)
+    for (int k = 0; k < ambient_model.output_layer_length; k++) {
+        outputs[k] = o[k] >= 1.0f ? MLP_Q15_MAX : (int16_t)(o[k] * MLP_Q15_ONE + 0.5f);
+    }
+
+    float threshold_one = 0.95f;
+    float threshold_zero = 0.05f;
+
+    // Verifica saída “quase perfeita”
+    for (int i = 0; i < ambient_model.output_layer_length; i++) {
+        if (o[i] >= threshold_one) {
+            int others_are_zero = 1;
+            for (int j = 0; j < ambient_model.output_layer_length; j++) {
+                if (j != i && o[j] > threshold_zero) {
+                    others_are_zero = 0;
+                    break;
+                }
+            }
+
+            if (others_are_zero) {
+                // Verificação extra com Lux: 0 Relax, 1 Work, 2 Party
+                if (lux >= config->mode_lux[i][0] && lux <= config->mode_lux[i][1]) return i;
+
+                return 3; // Lux fora da faixa → Outlier
+            }
+        }
+    }
+
+    return 3; // Incerto
+}
+
+/**
+ * @brief Processa uma leitura bruta: classificação e alertas usam a mediana da janela, de
+ * modo que uma leitura isolada fora da curva não faz a cor nem o alerta piscarem. O modo
+ * do ambiente usa o lux bruto da leitura.
+ * @param history Histórico das leituras, atualizado com raw.
+ * @param config Calibração e limiares (runtime_config no firmware).
+ * @param timestamp_ms Instante da leitura.
+ * @param raw Leituras brutas, na ordem de sensor_channel_t.
+ * @param sample Amostra preenchida.
+ */
+void classify_sample(sensor_history_t* history, const runtime_config_t* config, uint32_t timestamp_ms,
+                     const uint16_t raw[SENSOR_CHANNELS], sample_record_t* sample) {
+    sensor_history_push(history, timestamp_ms, raw);
+
+    sample->timestamp_ms = timestamp_ms;
+    sample->raw_lux = raw[SENSOR_LUX];
+    sample->raw_c = raw[SENSOR_CLEAR];
+    sample->raw_r = raw[SENSOR_RED];
+    sample->raw_g = raw[SENSOR_GREEN];
+    sample->raw_b = raw[SENSOR_BLUE];
+    sample->lux = sensor_history_median(history, SENSOR_LUX);
+
+    // Normalização para 0..255 por color_max_value. Com luz forte (leituras na escala da
+    // exposição de referência, gy33_normalize) o maior canal passa do limite: os três são
+    // escalados juntos, de modo que a cor se mantém e só o brilho satura.
+    uint16_t r = sensor_history_median(history, SENSOR_RED);
+    uint16_t g = sensor_history_median(history, SENSOR_GREEN);
+    uint16_t b = sensor_history_median(history, SENSOR_BLUE);
+    uint16_t scale = config->color_max_value;
+    if (r > scale) scale = r;
+    if (g > scale) scale = g;
+    if (b > scale) scale = b;
+    sample->r = map(r, 0, scale, 0, 255);
+    sample->g = map(g, 0, scale, 0, 255);
+    sample->b = map(b, 0, scale, 0, 255);
+    PROFILE_SCOPE(PROFILE_HSV) {
+        RGBtoHSV_fixed(sample->r, sample->g, sample->b, &sample->hsv); // Ponto fixo: o RP2040 não tem FPU
+        sample->cor = identificar_cor_hsv_fixed(&sample->hsv, &config->cor);
+    }
+
+    // --- Lógica de Alertas ---
+    bool low_light_alert = sample->lux < config->luminosity_threshold; // Se a luminosidade está abaixo do limiar, alerta de baixa luminosidade
+    bool intense_red_alert = (sample->cor == VERMELHO && cor_hsv_intensa(&sample->hsv, &config->cor)); // Se a saturação (> 0.6) e o valor (> 0.7) são altos, indica vermelho intenso
+    sample->alert = low_light_alert || intense_red_alert;
+
+    // O núcleo 1 ajusta o brilho com os limites que vieram na amostra, sempre de uma mesma
+    // configuração válida, sem ler runtime_config enquanto runtime_config_sync a troca
+    sample->lux_min = config->luminosity_threshold;
+    sample->lux_max = config->luminosity_max;
+
+    PROFILE_SCOPE(PROFILE_MLP) {
+        sample->mode = get_ambient_mode(sample->r, sample->g, sample->b, raw[SENSOR_LUX], config, sample->mlp_outputs);
+    }
+}
@@ -0,0 +1,26 @@
+#include "ambient_model.h"
+
+// Pesos do modelo treinado. Por ser const, o array fica na flash e é lido via XIP,
+// sem cópia para a RAM.
+static const float ambient_model_weights[MLP_CONST_WEIGHTS_LEN(AMBIENT_INPUT_LEN, AMBIENT_HIDDEN_LEN, AMBIENT_OUTPUT_LEN)] = {
+    // Camada oculta: [AMBIENT_HIDDEN_LEN][AMBIENT_INPUT_LEN + 1]
+    2.661857, 6.408717, 1.197877, -5.405861,
+    -2.044108, -5.768311, -0.194693, 4.042969,
+    3.156306, -5.066918, -4.585429, 1.241510,
+    -12.349979, -2.461361, 3.371196, 4.594296,
+    4.260282, -4.847218, -4.883586, 0.496394,
+
+    // Camada de saída: [AMBIENT_OUTPUT_LEN][AMBIENT_HIDDEN_LEN + 1]
+    -5.191444, 1.899328, -2.282097, 12.606183, -3.801378, -3.360971,
+    8.362973, -6.287300, -4.975049, -11.016505, -4.422555, 2.839259,
+    -6.135138, 2.244717, 5.509221, -5.429541, 6.808523, -3.378476,
+};
+
+const MLPConst ambient_model = {
+    .input_layer_length = AMBIENT_INPUT_LEN,
+    .hidden_layer_length = AMBIENT_HIDDEN_LEN,
+    .output_layer_length = AMBIENT_OUTPUT_LEN,
+    // Mesma ativação do treino; as aproximações mudam decisões de modo (host/bench/activation_bench.c)
+    .activation = MLP_ACTIVATION_LIBM,
+    .weights = ambient_model_weights,
+};
@@ -0,0 +1,32 @@
+#include "ambient_model.h"
+
+// Gerado por host/tools/mlp_quantize.c a partir de ambient_model.c; não editar à mão.
+// Pesos int8 com escala por camada e bias na escala do acumulador (ver MLPQ8 em mlp.h).
+static const int8_t ambient_model_q8_weights[MLP_Q8_WEIGHTS_LEN(AMBIENT_INPUT_LEN, AMBIENT_HIDDEN_LEN, AMBIENT_OUTPUT_LEN)] = {
+    // Camada oculta: [AMBIENT_HIDDEN_LEN][AMBIENT_INPUT_LEN]
+    27, 66, 12,
+    -21, -59, -2,
+    32, -52, -47,
+    -127, -25, 35,
+    44, -50, -50,
+
+    // Camada de saída: [AMBIENT_OUTPUT_LEN][AMBIENT_HIDDEN_LEN]
+    -52, 19, -23, 127, -38,
+    84, -63, -50, -111, -45,
+    -62, 23, 56, -55, 69,
+};
+
+static const int32_t ambient_model_q8_biases[MLP_Q8_BIASES_LEN(AMBIENT_INPUT_LEN, AMBIENT_HIDDEN_LEN, AMBIENT_OUTPUT_LEN)] = {
+    -1821597, 1362347, 418348, 1548126, 167268,
+    -1109519, 937292, -1115298,
+};
+
+const MLPQ8 ambient_model_q8 = {
+    .input_layer_length = AMBIENT_INPUT_LEN,
+    .hidden_layer_length = AMBIENT_HIDDEN_LEN,
+    .output_layer_length = AMBIENT_OUTPUT_LEN,
+    .weights = ambient_model_q8_weights,
+    .biases = ambient_model_q8_biases,
+    .hidden_scale = { 25492, 21 },
+    .output_scale = { 26021, 21 },
+};
@@ -18,6 +18,7 @@ const uint8_t _CONT_HRES_C = 0x10;  // Modo de alta resolução (1 lux)
 const uint8_t _CONT_HRES2_C = 0x11; // Modo de alta resolução 2 (0.5 lux)
 const uint8_t _CONT_LRES_C = 0x13;  // Modo de baixa resolução (4 lux)
 
+
 /**
  * @brief Push one byte of data to TX FIFO.
  * 
@@ -57,4 +58,60 @@ uint16_t bh1750_read_measurement(i2c_inst_t* i2c) {
     return (((uint16_t)buff[0] << 8) | buff[1]) / 1.2;
     // Obs. quando utilizar _CONT_HRES2_C dividir por 2.4
     // Quando utilizar _CONT_HRES_C dividir por 1.2
+}
+
+/**
+ * @brief Starts continuous H-resolution mode once, without waiting.
+ * The sensor keeps converting on its own; use bh1750_try_read() to
+ * pick up each new conversion.
+ *
+ * @param dev Driver state to initialize.
+ * @param i2c Initialized RP2040 I2C block.
+ */
+void bh1750_start_continuous(bh1750_t* dev, i2c_inst_t* i2c) {
+    dev->i2c = i2c;
+    dev->lux = 0;
+    _i2c_write_byte(i2c, _CONT_HRES_C);
+    dev->next_conversion = make_timeout_time_ms(BH1750_HRES_MEAS_TIME_MS);
+}
+
+/**
+ * @brief Checks whether a conversion newer than the last read is available.
+ *
+ * @param dev Driver state started with bh1750_start_continuous().
+ * @return true if bh1750_try_read() will fetch a fresh measurement.
+ */
+bool bh1750_data_ready(bh1750_t* dev) {
+    return absolute_time_diff_us(get_absolute_time(), dev->next_conversion) <= 0;
+}
+
+/**
+ * @brief Reads the measurement if a new conversion is ready; never sleeps.
+ *
+ * @param dev Driver state started with bh1750_start_continuous().
+ * @param lux Receives the measurement (lux) when one is read.
+ * @return true if a new measurement was read, false if still converting.
+ */
+bool bh1750_try_read(bh1750_t* dev, uint16_t* lux) {
+    if (!bh1750_data_ready(dev)) {
+        return false;
+    }
+
+    uint8_t buff[2];
+
+    if (i2c_read_blocking(dev->i2c, _BH1750_I2C_ADDR, buff, 2, false) != 2) {
+        return false;
+    }
+    // O sensor converte no próprio ritmo, então o prazo avança a partir do anterior; contar
+    // a partir do fim da leitura atrasaria o prazo a cada ciclo, e uma tarefa com o mesmo
+    // período acabaria encontrando a conversão ainda em andamento a cada duas execuções
+    dev->next_conversion = delayed_by_us(dev->next_conversion, BH1750_HRES_MEAS_TIME_MS * 1000);
+    if (bh1750_data_ready(dev)) {
+        dev->next_conversion = make_timeout_time_ms(BH1750_HRES_MEAS_TIME_MS); // Leitura atrasada: reancora
+    }
+
+    // Mesmo fator de _CONT_HRES_C (dividir por 1.2), em aritmética inteira
+    dev->lux = (((uint32_t)buff[0] << 8) | buff[1]) * 5 / 6;
+    *lux = dev->lux;
+    return true;
 }
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "buzzer.h"
+#include "hardware/gpio.h"
+#include "hardware/pwm.h"
+#include "pico/critical_section.h"
+
+static uint buzzer_pin;
+static critical_section_t buzzer_lock; // O alarme dispara no núcleo 0; buzzer_play pode vir do núcleo 1
+
+static const tone_pattern_t *queue[BUZZER_QUEUE_SIZE];
+static uint queue_head = 0, queue_count = 0;
+
+static const tone_pattern_t *current = NULL; // Padrão tocando (NULL = parado)
+static uint current_step = 0;
+static alarm_id_t buzzer_alarm = 0;
+
+// Duração de um passo em us; no mínimo 1 ms, para o alarme nunca disparar dentro de buzzer_play
+static int64_t step_us(const tone_step_t *step) {
+    return (int64_t)(step->duration_ms ? step->duration_ms : 1) * 1000;
+}
+
+// Começa o próximo padrão da fila; devolve a duração do primeiro passo em us, ou 0 se a fila está vazia
+static int64_t start_next_pattern(void) {
+    while (queue_count) {
+        current = queue[queue_head];
+        queue_head = (queue_head + 1) % BUZZER_QUEUE_SIZE;
+        queue_count--;
+        if (current->count) {
+            current_step = 0;
+            pwm_set_gpio_level(buzzer_pin, current->steps[0].level);
+            return step_us(&current->steps[0]);
+        }
+    }
+    current = NULL;
+    pwm_set_gpio_level(buzzer_pin, 0);
+    return 0;
+}
+
+// Fim de um passo: aplica o próximo nível. O retorno negativo reagenda a partir do
+// instante anterior, então as durações não acumulam a latência do callback.
+static int64_t buzzer_alarm_callback(alarm_id_t id, void *user_data) {
+    (void)id;
+    (void)user_data;
+    int64_t next_us;
+
+    critical_section_enter_blocking(&buzzer_lock);
+    if (current && ++current_step < current->count) {
+        pwm_set_gpio_level(buzzer_pin, current->steps[current_step].level);
+        next_us = step_us(&current->steps[current_step]);
+    } else {
+        next_us = start_next_pattern();
+    }
+    if (!next_us) buzzer_alarm = 0;
+    critical_section_exit(&buzzer_lock);
+
+    return -next_us;
+}
+
+/**
+ * @brief Configura o pino do buzzer para operar com PWM.
+ * @param pin GPIO ligado ao buzzer.
+ */
+void buzzer_init(uint pin) {
+    buzzer_pin = pin;
+    critical_section_init(&buzzer_lock);
+
+    gpio_set_function(pin, GPIO_FUNC_PWM);
+    uint slice_num = pwm_gpio_to_slice_num(pin);
+    pwm_config config = pwm_get_default_config();
+    pwm_config_set_clkdiv(&config, 488.0f);
+    pwm_config_set_wrap(&config, 255);
+    pwm_init(slice_num, &config, true);
+    pwm_set_gpio_level(pin, 0);
+}
+
+/**
+ * @brief Enfileira um padrão; se o buzzer está parado, começa a tocar na hora.
+ * Retorna imediatamente: os passos são aplicados pelo alarme.
+ * @param pattern Padrão a tocar (deve continuar válido até terminar, tipicamente const).
+ * @return false se a fila estava cheia.
+ */
+bool buzzer_play(const tone_pattern_t* pattern) {
+    bool queued = true;
+
+    critical_section_enter_blocking(&buzzer_lock);
+    if (queue_count == BUZZER_QUEUE_SIZE) {
+        queued = false;
+    } else {
+        queue[(queue_head + queue_count) % BUZZER_QUEUE_SIZE] = pattern;
+        queue_count++;
+        if (!current) {
+            int64_t first_us = start_next_pattern();
+            if (first_us) {
+                buzzer_alarm = add_alarm_in_us(first_us, buzzer_alarm_callback, NULL, true);
+            }
+        }
+    }
+    critical_section_exit(&buzzer_lock);
+    return queued;
+}
+
+/**
+ * @brief Interrompe o padrão atual, descarta a fila e silencia o buzzer.
+ */
+void buzzer_cancel(void) {
+    critical_section_enter_blocking(&buzzer_lock);
+    if (buzzer_alarm > 0) cancel_alarm(buzzer_alarm);
+    buzzer_alarm = 0;
+    queue_count = 0;
+    current = NULL;
+    pwm_set_gpio_level(buzzer_pin, 0);
+    critical_section_exit(&buzzer_lock);
+}
+
+/**
+ * @brief Indica se há um padrão tocando (ou na fila).
+ */
+bool buzzer_busy(void) {
+    return current != NULL;
+}
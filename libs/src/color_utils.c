@@ -1,5 +1,6 @@
 #include "color_utils.h"
 #include <math.h>   // Para as funções de ponto flutuante (HSV)
+#include <stdbool.h>
 
 /**
  * @brief Mapeia um número de uma faixa de valores para outra, mantendo a proporção.
@@ -89,6 +90,150 @@ CorIdentificada identificar_cor_hsv(float h, float s, float v) {
     return INDEFINIDO;
 }
 
+// --- Versão em ponto fixo ---
+
+#define HSV_H_60 (60 << HSV_H_FRAC_BITS)   // 60 graus em Q6
+#define HSV_H_360 (360 << HSV_H_FRAC_BITS) // Volta completa em Q6
+
+const LimiaresCor limiares_cor_padrao = LIMIARES_COR_PADRAO;
+
+// Empates exatos em que o arredondamento de RGBtoHSV() muda a classe com LIMIARES_COR_PADRAO,
+// levantados em todo o cubo RGB e conferidos contra a versão em float por
+// host/test/hsv_fixed_test.c.
+//
+// Cores (0xRRGGBB, em ordem crescente) cujo Hue exato é um grau em que a classe muda, mas cujo
+// Hue em float fica logo abaixo dele:
+static const uint32_t empates_hue_abaixo[] = {
+    0x0C100F, 0x18201E, 0x19211F, 0x1C201F, 0x1F1C20, 0x201F1D, 0x20211D, 0x21221E, 0x22231F, 0x231F20,
+    0x30403C, 0x31413D, 0x32423E, 0x33433F, 0x34403D, 0x35413E, 0x36423F, 0x38403E, 0x39413F, 0x3C403F,
+    0x3D3C40, 0x3D4041, 0x3E3840, 0x3E3D41, 0x3E4142, 0x3F3941, 0x3F3C40, 0x3F3E42, 0x3F4243, 0x403E3A,
+    0x403F3D, 0x40413D, 0x40423A, 0x413F3B, 0x41423E, 0x41433B, 0x42433F, 0x42443C, 0x433F40, 0x43453D,
+    0x44463E, 0x45473F, 0x463E40, 0x473F41, 0x5C8077, 0x5D8178, 0x5E8279, 0x5F837A, 0x608078, 0x60847B,
+    0x618179, 0x61857C, 0x62827A, 0x62867D, 0x63837B, 0x63877E, 0x648079, 0x64847C, 0x64887F, 0x65817A,
+    0x65857D, 0x66827B, 0x66867E, 0x67837C, 0x67877F, 0x68807A, 0x68847D, 0x69817B, 0x69857E, 0x6A827C,
+    0x6A867F, 0x6B837D, 0x6C807B, 0x6C847E, 0x6D817C, 0x6D857F, 0x6E827D, 0x6F837E, 0x70807C, 0x70847F,
+    0x71817D, 0x72827E, 0x73837F, 0x74807D, 0x75817E, 0x76827F, 0x777480, 0x778083, 0x787581, 0x78807E,
+    0x788184, 0x797682, 0x79817F, 0x798285, 0x7A7783, 0x7A7880, 0x7A8082, 0x7A8386, 0x7B6C80, 0x7B7884,
+    0x7B7981, 0x7B8183, 0x7B8487, 0x7C6D81, 0x7C7080, 0x7C7985, 0x7C7A82, 0x7C807F, 0x7C8284, 0x7C8588,
+    0x7D6E82, 0x7D7181, 0x7D7480, 0x7D7A86, 0x7D7B83, 0x7D7C80, 0x7D8081, 0x7D8385, 0x7D8689, 0x7E6F83,
+    0x7E7282, 0x7E7581, 0x7E7880, 0x7E7B87, 0x7E7C84, 0x7E7D81, 0x7E8182, 0x7E8486, 0x7E878A, 0x7F7084,
+    0x7F7383, 0x7F7682, 0x7F7981, 0x7F7C80, 0x7F7C88, 0x7F7D85, 0x7F7E82, 0x7F8283, 0x7F8587, 0x7F888B,
+    0x807B71, 0x807C74, 0x807D77, 0x807D7C, 0x807E7A, 0x807F7D, 0x80817D, 0x80827A, 0x808377, 0x808474,
+    0x808571, 0x817C72, 0x817D75, 0x817E78, 0x817E7D, 0x817F7B, 0x81827E, 0x81837B, 0x818478, 0x818575,
+    0x818672, 0x827D73, 0x827E76, 0x827F79, 0x827F7E, 0x82837F, 0x82847C, 0x828579, 0x828676, 0x828773,
+    0x837E74, 0x837F77, 0x837F80, 0x83857D, 0x83867A, 0x838777, 0x838874, 0x847F75, 0x84867E, 0x84877B,
+    0x848878, 0x848975, 0x85877F, 0x85887C, 0x858979, 0x858A76, 0x867E80, 0x86897D, 0x868A7A, 0x868B77,
+    0x877F81, 0x878A7E, 0x878B7B, 0x878C78, 0x888B7F, 0x888C7C, 0x888D79, 0x897D80, 0x898D7D, 0x898E7A,
+    0x8A7E81, 0x8A8E7E, 0x8A8F7B, 0x8B7F82, 0x8B8F7F, 0x8B907C, 0x8C7C80, 0x8C917D, 0x8D7D81, 0x8D927E,
+    0x8E7E82, 0x8E937F, 0x8F7B80, 0x8F7F83, 0x907C81, 0x917D82, 0x927E83, 0x937F84,
+};
+#define EMPATES_HUE_ABAIXO_COUNT (sizeof(empates_hue_abaixo) / sizeof(empates_hue_abaixo[0]))
+
+// Bit v / 4: com c * 4 == v (saturação exata de 25%, o limiar de branco), a saturação em
+// float fica abaixo de 0,25. No limiar de 60% o float nunca passa de 0,6f, como na conta exata.
+#define EMPATES_S25_ABAIXO 0xFFFFF800FFC0F8C8ull
+
+// Busca binária em empates_hue_abaixo
+static bool empate_hue_abaixo(uint32_t rgb) {
+    uint32_t lo = 0, hi = EMPATES_HUE_ABAIXO_COUNT;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if (empates_hue_abaixo[mid] == rgb) return true;
+        if (empates_hue_abaixo[mid] < rgb) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Converte RGB para HSV usando apenas aritmética inteira.
+ * O Hue é truncado para baixo em Q6. Fora de um grau exato, o piso do valor exato e o da
+ * versão em float coincidem; nos empates exatos em que o arredondamento do float muda a
+ * classe (tabelas acima), o resultado marca o lado em que o float cai em hsv->empates.
+ * @param r Componente Vermelho (0 a 255).
+ * @param g Componente Verde (0 a 255).
+ * @param b Componente Azul (0 a 255).
+ * @param hsv Ponteiro para a estrutura que recebe o resultado.
+ */
+void RGBtoHSV_fixed(uint8_t r, uint8_t g, uint8_t b, CorHSV *hsv) {
+    uint8_t cmax = r > g ? (r > b ? r : b) : (g > b ? g : b);
+    uint8_t cmin = r < g ? (r < b ? r : b) : (g < b ? g : b);
+    int32_t diff = cmax - cmin;
+    int32_t num;
+
+    hsv->v = cmax;
+    hsv->c = diff;
+    hsv->s = cmax ? (uint16_t)(((uint32_t)diff * HSV_S_ONE) / cmax) : 0;
+    hsv->empates = 0;
+    if (diff * 4 == cmax && ((EMPATES_S25_ABAIXO >> (cmax / 4)) & 1)) {
+        hsv->empates |= HSV_EMPATE_S_ABAIXO;
+    }
+
+    if (diff == 0) {
+        hsv->h = 0; // Tom de cinza
+        return;
+    }
+
+    // Mesma ordem de desempate da versão em float; somar o deslocamento antes de dividir
+    // mantém o numerador positivo, então a divisão inteira equivale ao piso
+    if (cmax == r) {
+        num = HSV_H_60 * (g - b) + HSV_H_360 * diff;
+    } else if (cmax == g) {
+        num = HSV_H_60 * (b - r) + 2 * HSV_H_60 * diff;
+    } else {
+        num = HSV_H_60 * (r - g) + 4 * HSV_H_60 * diff;
+    }
+    uint32_t h = (uint32_t)num / (uint32_t)diff;
+    hsv->h = h >= HSV_H_360 ? h - HSV_H_360 : h;
+
+    if ((uint32_t)num % ((uint32_t)diff << HSV_H_FRAC_BITS) == 0 &&
+        empate_hue_abaixo(((uint32_t)r << 16) | ((uint32_t)g << 8) | b)) {
+        hsv->empates |= HSV_EMPATE_H_ABAIXO;
+    }
+}
+
+// Compara c/v com pct% por multiplicação cruzada; no empate exato vale o lado marcado por
+// RGBtoHSV_fixed
+static int comparar_saturacao(const CorHSV *hsv, uint8_t pct) {
+    uint32_t a = (uint32_t)hsv->c * 100, b = (uint32_t)pct * hsv->v;
+    if (a != b) return a < b ? -1 : 1;
+    return (hsv->empates & HSV_EMPATE_S_ABAIXO) ? -1 : 0;
+}
+
+/**
+ * @brief Identifica a cor a partir do HSV em ponto fixo.
+ * Saturação e brilho são comparados por multiplicação cruzada com o croma e o maior componente
+ * (nos empates exatos vale o lado marcado em hsv->empates),
+ * e o Hue é classificado pela tabela de graus dos limiares.
+ * @param hsv Cor convertida por RGBtoHSV_fixed().
+ * @param lim Limiares (limiares_cor_padrao reproduz identificar_cor_hsv()).
+ * @return Uma enumeração `CorIdentificada` representando a cor detectada.
+ */
+CorIdentificada identificar_cor_hsv_fixed(const CorHSV *hsv, const LimiaresCor *lim) {
+    // v < v_min%
+    if (hsv->v * 100 < lim->v_min * 255) return INDEFINIDO;
+    // s < branco_s_max% e v > branco_v_min%
+    if (hsv->v * 100 > lim->branco_v_min * 255 && comparar_saturacao(hsv, lim->branco_s_max) < 0) return BRANCO;
+
+    uint16_t grau = hsv->h >> HSV_H_FRAC_BITS;
+    if (hsv->empates & HSV_EMPATE_H_ABAIXO) grau = grau ? grau - 1 : 359; // O float fica logo abaixo do grau
+    return (CorIdentificada)lim->cor_por_grau[grau];
+}
+
+/**
+ * @brief Verifica se a cor é intensa (s > intensa_s_min% e v > intensa_v_min%), critério do
+ * alerta de vermelho intenso.
+ * @param hsv Cor convertida por RGBtoHSV_fixed().
+ * @param lim Limiares.
+ * @return 1 se a cor é intensa, 0 caso contrário.
+ */
+int cor_hsv_intensa(const CorHSV *hsv, const LimiaresCor *lim) {
+    return hsv->v * 100 > lim->intensa_v_min * 255 && comparar_saturacao(hsv, lim->intensa_s_min) > 0;
+}
+
 /**
  * @brief Retorna uma cor RGB "pura" (valor máximo) para uma dada cor identificada.
  * @param cor A cor identificada pela enumeração.
@@ -0,0 +1,269 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "flash_log.h"
+#include "telemetry.h"
+#include "config.h"
+
+#define PAGES (FLASH_LOG_SECTORS * FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE)
+#define PAGES_PER_SECTOR (FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE)
+#define PAYLOAD_MAX (FLASH_PAGE_SIZE - FLASH_LOG_HEADER_LEN)
+
+static uint32_t head_page;  // Próxima página a gravar (índice dentro da região)
+static uint32_t next_seq;   // Sequência da próxima página
+static uint8_t page[FLASH_PAGE_SIZE];
+static uint8_t page_len;    // Bytes de registros em page
+static flash_log_entry_t last; // Último registro da página, base dos deltas
+static bool boot_pending;
+static flash_log_stats_t stats;
+
+typedef struct {
+    uint32_t offset;
+    bool erase;
+} flash_write_t;
+
+static const uint8_t* page_in_flash(uint32_t index) {
+    return (const uint8_t*)(XIP_BASE + FLASH_LOG_OFFSET + index * FLASH_PAGE_SIZE);
+}
+
+static uint8_t* put_uvarint(uint8_t* p, uint32_t v) {
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+static const uint8_t* get_uvarint(const uint8_t* p, const uint8_t* end, uint32_t* v) {
+    *v = 0;
+    for (int shift = 0; shift < 35 && p < end; shift += 7) {
+        uint8_t byte = *p++;
+        *v |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return p;
+    }
+    return NULL;
+}
+
+// Zigzag: deltas pequenos, positivos ou negativos, viram varints de um byte
+static inline uint32_t zigzag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static inline int32_t unzigzag(uint32_t v) {
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+static size_t encode_record(const flash_log_entry_t* e, const flash_log_entry_t* prev, uint8_t* out) {
+    uint8_t* p = out;
+    *p++ = (uint8_t)((e->cor & 0x0F) | ((e->mode & 0x03) << 4) | (e->alert ? 0x40 : 0) | (e->boot ? 0x80 : 0));
+    p = put_uvarint(p, e->timestamp_ms - prev->timestamp_ms);
+    for (int ch = 0; ch < SENSOR_CHANNELS; ch++) {
+        p = put_uvarint(p, zigzag((int32_t)e->raw[ch] - (int32_t)prev->raw[ch]));
+    }
+    return (size_t)(p - out);
+}
+
+// CRC dos 8 primeiros bytes do cabeçalho seguidos dos registros
+static uint16_t page_crc(const uint8_t* p, uint8_t len) {
+    uint8_t buf[8 + PAYLOAD_MAX];
+    memcpy(buf, p, 8);
+    memcpy(buf + 8, p + FLASH_LOG_HEADER_LEN, len);
+    return telemetry_crc16(buf, 8 + len);
+}
+
+// Preenche o cabeçalho de uma página com len bytes de registros
+static void seal_page(uint8_t* p, uint8_t len, uint32_t seq) {
+    p[0] = (uint8_t)FLASH_LOG_MAGIC;
+    p[1] = (uint8_t)(FLASH_LOG_MAGIC >> 8);
+    p[2] = FLASH_LOG_VERSION;
+    p[3] = len;
+    p[4] = (uint8_t)seq;
+    p[5] = (uint8_t)(seq >> 8);
+    p[6] = (uint8_t)(seq >> 16);
+    p[7] = (uint8_t)(seq >> 24);
+    uint16_t crc = page_crc(p, len);
+    p[8] = (uint8_t)crc;
+    p[9] = (uint8_t)(crc >> 8);
+}
+
+// Roda com o outro núcleo pausado e as interrupções desligadas (flash_safe_execute)
+static void flash_write(void* param) {
+    const flash_write_t* w = param;
+    if (w->erase) flash_range_erase(w->offset - w->offset % FLASH_SECTOR_SIZE, FLASH_SECTOR_SIZE);
+    flash_range_program(w->offset, page, FLASH_PAGE_SIZE);
+}
+
+// Grava a página da RAM; se o flash_safe_execute falhar, nada foi gravado e ela continua na RAM
+static bool write_page(void) {
+    seal_page(page, page_len, next_seq);
+    memset(page + FLASH_LOG_HEADER_LEN + page_len, 0xFF, PAYLOAD_MAX - page_len);
+
+    // O setor só é apagado quando a escrita entra nele: desgaste igual em toda a região
+    flash_write_t w = {FLASH_LOG_OFFSET + head_page * FLASH_PAGE_SIZE, head_page % PAGES_PER_SECTOR == 0};
+    if (flash_safe_execute(flash_write, &w, UINT32_MAX) != PICO_OK) {
+        stats.failed_writes++;
+        return false;
+    }
+
+    head_page = (head_page + 1) % PAGES;
+    next_seq++;
+    page_len = 0;
+    return true;
+}
+
+static bool page_blank(const uint8_t* p) {
+    for (uint i = 0; i < FLASH_PAGE_SIZE; i++) {
+        if (p[i] != 0xFF) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Confere magic, versão, tamanho e CRC de uma página.
+ * @param p Página.
+ * @param len Bytes disponíveis em p (a página inteira na flash, ou o quadro do dump).
+ * @param seq Número de sequência da página, se válida.
+ * @return true se a página é válida.
+ */
+bool flash_log_page_valid(const uint8_t* p, size_t len, uint32_t* seq) {
+    if (len < FLASH_LOG_HEADER_LEN) return false;
+    if ((p[0] | (p[1] << 8)) != FLASH_LOG_MAGIC || p[2] != FLASH_LOG_VERSION) return false;
+    if (p[3] > PAYLOAD_MAX || FLASH_LOG_HEADER_LEN + (size_t)p[3] > len) return false;
+    if ((p[8] | (p[9] << 8)) != page_crc(p, p[3])) return false;
+    *seq = p[4] | (p[5] << 8) | (p[6] << 16) | ((uint32_t)p[7] << 24);
+    return true;
+}
+
+/**
+ * @brief Localiza o fim do log: a página válida de maior sequência. A escrita continua na
+ * página seguinte; se ela não estiver apagada (gravação interrompida), pula para o próximo
+ * setor, que será apagado antes do uso.
+ */
+void flash_log_init(void) {
+    bool found = false;
+    uint32_t best_page = 0, best_seq = 0;
+
+    for (uint32_t i = 0; i < PAGES; i++) {
+        uint32_t seq;
+        if (flash_log_page_valid(page_in_flash(i), FLASH_PAGE_SIZE, &seq) && (!found || (int32_t)(seq - best_seq) > 0)) {
+            found = true;
+            best_page = i;
+            best_seq = seq;
+        }
+    }
+
+    head_page = found ? (best_page + 1) % PAGES : 0;
+    next_seq = found ? best_seq + 1 : 0;
+    if (head_page % PAGES_PER_SECTOR && !page_blank(page_in_flash(head_page))) {
+        head_page = (head_page / PAGES_PER_SECTOR + 1) * PAGES_PER_SECTOR % PAGES;
+    }
+    page_len = 0;
+    boot_pending = true;
+}
+
+/**
+ * @brief Acrescenta uma amostra ao log. Grava a página na flash quando ela enche; a
+ * gravação pausa o outro núcleo por ~1 ms (ou ~45 ms quando apaga um setor).
+ * @param sample Amostra com as leituras brutas e as decisões.
+ */
+void flash_log_append(const sample_record_t* sample) {
+    flash_log_entry_t e = {
+        .timestamp_ms = sample->timestamp_ms,
+        .raw = {[SENSOR_LUX] = sample->raw_lux, [SENSOR_RED] = sample->raw_r, [SENSOR_GREEN] = sample->raw_g,
+                [SENSOR_BLUE] = sample->raw_b, [SENSOR_CLEAR] = sample->raw_c},
+        .cor = (uint8_t)sample->cor,
+        .mode = sample->mode,
+        .alert = sample->alert,
+        .boot = boot_pending,
+    };
+    static const flash_log_entry_t zero;
+    uint8_t record[FLASH_LOG_RECORD_MAX_LEN];
+
+    size_t len = encode_record(&e, page_len ? &last : &zero, record);
+    if (page_len + len > PAYLOAD_MAX) {
+        if (!write_page()) {
+            // A página cheia fica na RAM e a gravação é tentada de novo na próxima amostra
+            stats.dropped_samples++;
+            return;
+        }
+        len = encode_record(&e, &zero, record);
+    }
+    memcpy(page + FLASH_LOG_HEADER_LEN + page_len, record, len);
+    page_len += len;
+    last = e;
+    boot_pending = false;
+}
+
+/**
+ * @brief Falhas de gravação desde o boot.
+ */
+flash_log_stats_t flash_log_stats(void) {
+    return stats;
+}
+
+static void emit_frame(int (*put)(int c), const uint8_t* p, size_t len) {
+    uint8_t frame[COBS_MAX_ENCODED_LEN(FLASH_PAGE_SIZE)];
+    size_t n = cobs_encode(p, len, frame);
+    for (size_t i = 0; i < n; i++) put(frame[i]);
+    put(0);
+}
+
+/**
+ * @brief Envia o log como quadros COBS, da página mais antiga à mais recente.
+ * @param put Saída de um byte (putchar_raw na USB).
+ */
+void flash_log_dump(int (*put)(int c)) {
+    put(0); // Descarta no receptor o que veio antes (texto do log, por exemplo)
+
+    for (uint32_t i = 0; i < PAGES; i++) {
+        const uint8_t* p = page_in_flash((head_page + i) % PAGES);
+        uint32_t seq;
+        if (flash_log_page_valid(p, FLASH_PAGE_SIZE, &seq)) emit_frame(put, p, FLASH_LOG_HEADER_LEN + p[3]);
+    }
+
+    // Página ainda na RAM, com o número de sequência que terá na flash
+    if (page_len) {
+        uint8_t pending[FLASH_PAGE_SIZE];
+        memcpy(pending, page, FLASH_LOG_HEADER_LEN + page_len);
+        seal_page(pending, page_len, next_seq);
+        emit_frame(put, pending, FLASH_LOG_HEADER_LEN + page_len);
+    }
+}
+
+/**
+ * @brief Posiciona o cursor no primeiro registro de uma página válida.
+ */
+void flash_log_cursor_init(flash_log_cursor_t* cursor, const uint8_t* p) {
+    cursor->next = p + FLASH_LOG_HEADER_LEN;
+    cursor->end = cursor->next + p[3];
+    memset(&cursor->prev, 0, sizeof(cursor->prev));
+}
+
+/**
+ * @brief Decodifica o próximo registro da página.
+ * @return false no fim da página ou se o registro estiver truncado.
+ */
+bool flash_log_cursor_next(flash_log_cursor_t* cursor, flash_log_entry_t* entry) {
+    const uint8_t* p = cursor->next;
+    uint32_t v;
+
+    if (p >= cursor->end) return false;
+    uint8_t flags = *p++;
+    entry->cor = flags & 0x0F;
+    entry->mode = (flags >> 4) & 0x03;
+    entry->alert = flags & 0x40;
+    entry->boot = flags & 0x80;
+
+    if (!(p = get_uvarint(p, cursor->end, &v))) return false;
+    entry->timestamp_ms = cursor->prev.timestamp_ms + v;
+    for (int ch = 0; ch < SENSOR_CHANNELS; ch++) {
+        if (!(p = get_uvarint(p, cursor->end, &v))) return false;
+        entry->raw[ch] = (uint16_t)(cursor->prev.raw[ch] + unzigzag(v));
+    }
+
+    cursor->next = p;
+    cursor->prev = *entry;
+    return true;
+}
@@ -2,30 +2,163 @@
 #include "config.h"
 #include "hardware/i2c.h"
 
+#define GY33_STATUS_AVALID 0x01 // Uma integração completa desde o último AEN
+
+// Faixa alvo do canal Clear, em fração do fundo de escala: abaixo de 10% sobe a exposição,
+// acima de 75% desce
+#define GY33_TARGET_LOW_PERCENT 10
+#define GY33_TARGET_HIGH_PERCENT 75
+
+typedef struct {
+    uint8_t atime; // Integração de (256 - atime) ciclos de 2,4 ms
+    uint8_t again; // Ganho: 0 1x, 1 4x, 2 16x, 3 60x
+} gy33_exposure_step_t;
+
+// Escada de exposição, da menor à maior. Com luz forte o ganho cai primeiro e a integração
+// encurta para 24 ms (~41 leituras/s); no escuro o ganho vai a 60x e a integração a 240 ms,
+// não mais, para a janela de medianas ainda acompanhar a cena (~4 leituras/s).
+// O fundo de escala é ciclos x 1024 (até 65535), então trocar só o ATIME abaixo de 64 ciclos
+// não muda a fração do fundo de escala que o controle observa: entre os passos 2 e 3 a
+// leitura só encurta, e o controle dá mais um passo na leitura seguinte. Nos demais passos a
+// fração muda de 1,56x a 4x, menos que a razão 7,5x entre os limites da faixa alvo: nenhum
+// passo leva a leitura de um lado da faixa ao outro, e o controle não oscila.
+static const gy33_exposure_step_t exposure_steps[] = {
+    {0xF6, 0}, // 10 ciclos (24 ms), 1x
+    {0xF6, 1}, // 24 ms, 4x
+    {0xF6, 2}, // 24 ms, 16x
+    {0xD5, 2}, // 43 ciclos (103 ms), 16x: a referência, usada no boot
+    {0xD5, 3}, // 103 ms, 60x
+    {0x9C, 3}, // 100 ciclos (240 ms), 60x
+};
+#define EXPOSURE_STEPS_COUNT (sizeof(exposure_steps) / sizeof(exposure_steps[0]))
+#define EXPOSURE_STEP_DEFAULT 3
+
+static const uint8_t gain_factor[4] = {1, 4, 16, 60};
+
+static uint8_t exposure_step = EXPOSURE_STEP_DEFAULT;
+
+// Grava ATIME e ganho e reinicia a integração, para a próxima leitura válida ser inteira
+// com a exposição nova (o AVALID só volta depois dela)
+static void apply_exposure_step() {
+    const gy33_exposure_step_t *step = &exposure_steps[exposure_step];
+    gy33_write_register(ENABLE_REG, 0x01);
+    gy33_write_register(ATIME_REG, step->atime);
+    gy33_write_register(CONTROL_REG, step->again);
+    gy33_write_register(ENABLE_REG, 0x03);
+}
+
 /**
- * @brief Inicializa o sensor de cor GY-33 com configurações padrão.
- * Ativa o sensor, define o tempo de integração e o ganho para 16x.
+ * @brief Inicializa o sensor de cor GY-33 na exposição de referência.
+ * Ativa o sensor, define o tempo de integração (~103 ms) e o ganho para 16x.
  */
 void gy33_init() {
+    exposure_step = EXPOSURE_STEP_DEFAULT;
     gy33_write_register(ENABLE_REG, 0x01);
     sleep_ms(3);
-    gy33_write_register(ENABLE_REG, 0x03);
-    gy33_write_register(ATIME_REG, 0xD5);
-    gy33_write_register(CONTROL_REG, 0x02); // Ganho 16x
+    apply_exposure_step();
+}
+
+/**
+ * @brief Tempo de um ciclo de integração com o ATIME configurado; é o intervalo em que
+ * o sensor produz uma leitura nova.
+ * @return Tempo de integração em microssegundos.
+ */
+uint32_t gy33_integration_time_us() {
+    return (256 - exposure_steps[exposure_step].atime) * GY33_ATIME_CYCLE_US;
+}
+
+/**
+ * @brief Exposição atual: ganho vezes ciclos de integração.
+ */
+uint32_t gy33_exposure() {
+    const gy33_exposure_step_t *step = &exposure_steps[exposure_step];
+    return gain_factor[step->again] * (uint32_t)(256 - step->atime);
+}
+
+/**
+ * @brief Controle automático de exposição: mantém o canal Clear (o maior dos quatro) na faixa
+ * alvo, um passo por leitura. Uma mudança reinicia a integração.
+ * @param clear Canal Clear bruto da última leitura, feita com a exposição atual.
+ * @return true se a exposição mudou; a próxima leitura válida sai depois de
+ * gy33_integration_time_us() + GY33_RESTART_US.
+ */
+bool gy33_auto_exposure(uint16_t clear) {
+    uint32_t full_scale = (256 - exposure_steps[exposure_step].atime) * 1024;
+    if (full_scale > 65535) full_scale = 65535;
+
+    if (clear * 100 > full_scale * GY33_TARGET_HIGH_PERCENT && exposure_step > 0) {
+        exposure_step--;
+    } else if (clear * 100 < full_scale * GY33_TARGET_LOW_PERCENT && exposure_step < EXPOSURE_STEPS_COUNT - 1) {
+        exposure_step++;
+    } else {
+        return false;
+    }
+    apply_exposure_step();
+    return true;
+}
+
+/**
+ * @brief Converte uma leitura feita com a exposição atual para a escala da exposição de
+ * referência. Acima de 16 bits os quatro canais são reduzidos na mesma proporção, o que
+ * preserva a cor (só a intensidade satura).
+ * @param color Leitura bruta, convertida no lugar.
+ */
+void gy33_normalize(gy33_color_t *color) {
+    uint32_t exposure = gy33_exposure();
+    uint32_t c = ((uint32_t)color->c * GY33_REFERENCE_EXPOSURE + exposure / 2) / exposure;
+    uint32_t r = ((uint32_t)color->r * GY33_REFERENCE_EXPOSURE + exposure / 2) / exposure;
+    uint32_t g = ((uint32_t)color->g * GY33_REFERENCE_EXPOSURE + exposure / 2) / exposure;
+    uint32_t b = ((uint32_t)color->b * GY33_REFERENCE_EXPOSURE + exposure / 2) / exposure;
+
+    if (c > 65535) { // Clear é o maior canal
+        r = (uint64_t)r * 65535 / c;
+        g = (uint64_t)g * 65535 / c;
+        b = (uint64_t)b * 65535 / c;
+        c = 65535;
+    }
+    color->c = c;
+    color->r = r;
+    color->g = g;
+    color->b = b;
 }
 
 /**
  * @brief Lê os valores brutos dos canais Clear, Red, Green e Blue do sensor.
+ * Se a leitura falhar, as saídas não são alteradas.
  * @param r Ponteiro para armazenar o valor do canal Vermelho.
  * @param g Ponteiro para armazenar o valor do canal Verde.
  * @param b Ponteiro para armazenar o valor do canal Azul.
  * @param c Ponteiro para armazenar o valor do canal Clear (intensidade).
+ * @return O mesmo de gy33_read_color_burst().
+ */
+bool gy33_read_color(uint16_t *r, uint16_t *g, uint16_t *b, uint16_t *c) {
+    gy33_color_t color;
+    if (!gy33_read_color_burst(&color)) return false;
+    *c = color.c;
+    *r = color.r;
+    *g = color.g;
+    *b = color.b;
+    return true;
+}
+
+/**
+ * @brief Lê os canais Clear, Red, Green e Blue em uma única transação.
+ * Usa o auto-incremento do sensor para ler STATUS_REG e os 8 bytes consecutivos a partir
+ * de CDATA_REG, garantindo que os quatro canais sejam do mesmo ciclo de integração.
+ * @param color Ponteiro para a estrutura que recebe os quatro canais (brutos).
+ * @return true se a leitura foi concluída, false em caso de erro no barramento ou se
+ * nenhuma integração terminou desde a última mudança de exposição.
  */
-void gy33_read_color(uint16_t *r, uint16_t *g, uint16_t *b, uint16_t *c) {
-    *c = gy33_read_register(CDATA_REG);
-    *r = gy33_read_register(RDATA_REG);
-    *g = gy33_read_register(GDATA_REG);
-    *b = gy33_read_register(BDATA_REG);
+bool gy33_read_color_burst(gy33_color_t *color) {
+    uint8_t buffer[9];
+    uint8_t val = STATUS_REG | GY33_COMMAND_BIT | GY33_AUTO_INCREMENT;
+    if (i2c_write_blocking(I2C_PORT_SENSORS, GY33_I2C_ADDR, &val, 1, true) != 1) return false;
+    if (i2c_read_blocking(I2C_PORT_SENSORS, GY33_I2C_ADDR, buffer, 9, false) != 9) return false;
+    color->c = (buffer[2] << 8) | buffer[1];
+    color->r = (buffer[4] << 8) | buffer[3];
+    color->g = (buffer[6] << 8) | buffer[5];
+    color->b = (buffer[8] << 8) | buffer[7];
+    return buffer[0] & GY33_STATUS_AVALID;
 }
 
 /**
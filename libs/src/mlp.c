@@ -17,6 +17,125 @@ float tanhyper(float z) {
 	return tanhf(z);
 }
 
+// Aproximação linear por partes da sigmoid (PLAN), com simetria sigmoid(-z) = 1 - sigmoid(z)
+float sigmoid_pwl(float z) {
+	float a = fabsf(z), y;
+
+	if(a >= 5.0f) y = 1.0f;
+	else if(a >= 2.375f) y = 0.03125f * a + 0.84375f;
+	else if(a >= 1.0f) y = 0.125f * a + 0.625f;
+	else y = 0.25f * a + 0.5f;
+
+	return z < 0 ? 1.0f - y : y;
+}
+
+// tanh(z) = 2 * sigmoid(2z) - 1
+float tanh_pwl(float z) {
+	return 2.0f * sigmoid_pwl(2.0f * z) - 1.0f;
+}
+
+// sigmoid(i / 32) para i = 0..512 (2 KB na flash)
+static const float sigmoid_table[513] = {
+	0.500000000f, 0.507811864f, 0.515619916f, 0.523420349f, 0.531209373f, 0.538983221f, 0.546738152f, 0.554470465f,
+	0.562176501f, 0.569852651f, 0.577495365f, 0.585101154f, 0.592666600f, 0.600188359f, 0.607663170f, 0.615087856f,
+	0.622459331f, 0.629774607f, 0.637030794f, 0.644225106f, 0.651354865f, 0.658417501f, 0.665410559f, 0.672331699f,
+	0.679178699f, 0.685949455f, 0.692641983f, 0.699254421f, 0.705785028f, 0.712232184f, 0.718594393f, 0.724870276f,
+	0.731058579f, 0.737158163f, 0.743168009f, 0.749087213f, 0.754914987f, 0.760650653f, 0.766293643f, 0.771843498f,
+	0.777299861f, 0.782662479f, 0.787931196f, 0.793105951f, 0.798186778f, 0.803173796f, 0.808067214f, 0.812867318f,
+	0.817574476f, 0.822189131f, 0.826711794f, 0.831143048f, 0.835483537f, 0.839733968f, 0.843895103f, 0.847967758f,
+	0.851952802f, 0.855851147f, 0.859663751f, 0.863391610f, 0.867035760f, 0.870597268f, 0.874077235f, 0.877476787f,
+	0.880797078f, 0.884039282f, 0.887204594f, 0.890294226f, 0.893309406f, 0.896251373f, 0.899121377f, 0.901920677f,
+	0.904650535f, 0.907312221f, 0.909907006f, 0.912436160f, 0.914900955f, 0.917302657f, 0.919642531f, 0.921921835f,
+	0.924141820f, 0.926303730f, 0.928408801f, 0.930458255f, 0.932453309f, 0.934395163f, 0.936285006f, 0.938124014f,
+	0.939913350f, 0.941654159f, 0.943347575f, 0.944994712f, 0.946596670f, 0.948154533f, 0.949669367f, 0.951142221f,
+	0.952574127f, 0.953966098f, 0.955319130f, 0.956634201f, 0.957912272f, 0.959154284f, 0.960361161f, 0.961533808f,
+	0.962673113f, 0.963779944f, 0.964855154f, 0.965899574f, 0.966914022f, 0.967899293f, 0.968856169f, 0.969785413f,
+	0.970687769f, 0.971563967f, 0.972414718f, 0.973240717f, 0.974042643f, 0.974821158f, 0.975576910f, 0.976310529f,
+	0.977022630f, 0.977713814f, 0.978384667f, 0.979035759f, 0.979667647f, 0.980280872f, 0.980875963f, 0.981453435f,
+	0.982013790f, 0.982557515f, 0.983085087f, 0.983596967f, 0.984093608f, 0.984575448f, 0.985042913f, 0.985496420f,
+	0.985936373f, 0.986363165f, 0.986777178f, 0.987178786f, 0.987568349f, 0.987946220f, 0.988312742f, 0.988668246f,
+	0.989013057f, 0.989347489f, 0.989671847f, 0.989986429f, 0.990291524f, 0.990587410f, 0.990874363f, 0.991152645f,
+	0.991422515f, 0.991684222f, 0.991938008f, 0.992184111f, 0.992422759f, 0.992654173f, 0.992878571f, 0.993096162f,
+	0.993307149f, 0.993511730f, 0.993710098f, 0.993902438f, 0.994088931f, 0.994269753f, 0.994445075f, 0.994615062f,
+	0.994779874f, 0.994939668f, 0.995094594f, 0.995244800f, 0.995390428f, 0.995531616f, 0.995668498f, 0.995801205f,
+	0.995929862f, 0.996054593f, 0.996175516f, 0.996292747f, 0.996406397f, 0.996516576f, 0.996623388f, 0.996726935f,
+	0.996827317f, 0.996924630f, 0.997018967f, 0.997110419f, 0.997199073f, 0.997285015f, 0.997368326f, 0.997449088f,
+	0.997527377f, 0.997603269f, 0.997676837f, 0.997748153f, 0.997817284f, 0.997884297f, 0.997949256f, 0.998012226f,
+	0.998073265f, 0.998132434f, 0.998189789f, 0.998245386f, 0.998299278f, 0.998351517f, 0.998402155f, 0.998451239f,
+	0.998498818f, 0.998544937f, 0.998589642f, 0.998632974f, 0.998674978f, 0.998715692f, 0.998755157f, 0.998793410f,
+	0.998830490f, 0.998866431f, 0.998901269f, 0.998935037f, 0.998967769f, 0.998999496f, 0.999030248f, 0.999060056f,
+	0.999088949f, 0.999116954f, 0.999144099f, 0.999170411f, 0.999195914f, 0.999220634f, 0.999244594f, 0.999267819f,
+	0.999290330f, 0.999312149f, 0.999333298f, 0.999353797f, 0.999373666f, 0.999392924f, 0.999411591f, 0.999429684f,
+	0.999447221f, 0.999464219f, 0.999480695f, 0.999496664f, 0.999512143f, 0.999527146f, 0.999541687f, 0.999555782f,
+	0.999569443f, 0.999582684f, 0.999595519f, 0.999607958f, 0.999620015f, 0.999631702f, 0.999643029f, 0.999654008f,
+	0.999664650f, 0.999674964f, 0.999684961f, 0.999694651f, 0.999704043f, 0.999713146f, 0.999721969f, 0.999730521f,
+	0.999738810f, 0.999746844f, 0.999754631f, 0.999762178f, 0.999769493f, 0.999776584f, 0.999783456f, 0.999790117f,
+	0.999796573f, 0.999802831f, 0.999808896f, 0.999814774f, 0.999820472f, 0.999825995f, 0.999831347f, 0.999836535f,
+	0.999841564f, 0.999846438f, 0.999851162f, 0.999855740f, 0.999860178f, 0.999864479f, 0.999868648f, 0.999872689f,
+	0.999876605f, 0.999880401f, 0.999884081f, 0.999887647f, 0.999891103f, 0.999894453f, 0.999897700f, 0.999900847f,
+	0.999903898f, 0.999906854f, 0.999909720f, 0.999912497f, 0.999915189f, 0.999917798f, 0.999920327f, 0.999922778f,
+	0.999925154f, 0.999927456f, 0.999929688f, 0.999931851f, 0.999933948f, 0.999935980f, 0.999937950f, 0.999939858f,
+	0.999941709f, 0.999943502f, 0.999945240f, 0.999946925f, 0.999948558f, 0.999950140f, 0.999951674f, 0.999953161f,
+	0.999954602f, 0.999955999f, 0.999957353f, 0.999958665f, 0.999959936f, 0.999961169f, 0.999962364f, 0.999963521f,
+	0.999964644f, 0.999965732f, 0.999966786f, 0.999967808f, 0.999968798f, 0.999969758f, 0.999970688f, 0.999971590f,
+	0.999972464f, 0.999973311f, 0.999974133f, 0.999974928f, 0.999975700f, 0.999976447f, 0.999977172f, 0.999977874f,
+	0.999978555f, 0.999979215f, 0.999979854f, 0.999980474f, 0.999981075f, 0.999981657f, 0.999982221f, 0.999982768f,
+	0.999983299f, 0.999983812f, 0.999984310f, 0.999984793f, 0.999985261f, 0.999985714f, 0.999986154f, 0.999986580f,
+	0.999986993f, 0.999987393f, 0.999987781f, 0.999988157f, 0.999988521f, 0.999988874f, 0.999989217f, 0.999989548f,
+	0.999989870f, 0.999990182f, 0.999990484f, 0.999990777f, 0.999991060f, 0.999991335f, 0.999991602f, 0.999991860f,
+	0.999992111f, 0.999992353f, 0.999992589f, 0.999992817f, 0.999993038f, 0.999993252f, 0.999993460f, 0.999993661f,
+	0.999993856f, 0.999994045f, 0.999994228f, 0.999994406f, 0.999994578f, 0.999994745f, 0.999994906f, 0.999995063f,
+	0.999995215f, 0.999995362f, 0.999995505f, 0.999995643f, 0.999995777f, 0.999995907f, 0.999996033f, 0.999996155f,
+	0.999996273f, 0.999996388f, 0.999996499f, 0.999996607f, 0.999996711f, 0.999996812f, 0.999996911f, 0.999997006f,
+	0.999997098f, 0.999997187f, 0.999997274f, 0.999997357f, 0.999997439f, 0.999997518f, 0.999997594f, 0.999997668f,
+	0.999997740f, 0.999997809f, 0.999997877f, 0.999997942f, 0.999998005f, 0.999998067f, 0.999998126f, 0.999998184f,
+	0.999998240f, 0.999998294f, 0.999998346f, 0.999998397f, 0.999998447f, 0.999998494f, 0.999998541f, 0.999998586f,
+	0.999998629f, 0.999998671f, 0.999998712f, 0.999998752f, 0.999998790f, 0.999998827f, 0.999998863f, 0.999998898f,
+	0.999998932f, 0.999998965f, 0.999998997f, 0.999999028f, 0.999999058f, 0.999999087f, 0.999999115f, 0.999999142f,
+	0.999999168f, 0.999999194f, 0.999999219f, 0.999999243f, 0.999999266f, 0.999999289f, 0.999999311f, 0.999999332f,
+	0.999999352f, 0.999999372f, 0.999999392f, 0.999999410f, 0.999999428f, 0.999999446f, 0.999999463f, 0.999999480f,
+	0.999999496f, 0.999999511f, 0.999999526f, 0.999999541f, 0.999999555f, 0.999999569f, 0.999999582f, 0.999999595f,
+	0.999999607f, 0.999999619f, 0.999999631f, 0.999999642f, 0.999999653f, 0.999999664f, 0.999999674f, 0.999999684f,
+	0.999999694f, 0.999999704f, 0.999999713f, 0.999999721f, 0.999999730f, 0.999999738f, 0.999999746f, 0.999999754f,
+	0.999999762f, 0.999999769f, 0.999999776f, 0.999999783f, 0.999999790f, 0.999999796f, 0.999999802f, 0.999999809f,
+	0.999999814f, 0.999999820f, 0.999999826f, 0.999999831f, 0.999999836f, 0.999999841f, 0.999999846f, 0.999999851f,
+	0.999999856f, 0.999999860f, 0.999999864f, 0.999999868f, 0.999999872f, 0.999999876f, 0.999999880f, 0.999999884f,
+	0.999999887f,
+};
+
+float sigmoid_lut(float z) {
+	float x = fabsf(z) * 32.0f, y;
+
+	if(x >= 512.0f) {
+		y = sigmoid_table[512];
+	} else {
+		int i = (int)x;
+		y = sigmoid_table[i] + (sigmoid_table[i + 1] - sigmoid_table[i]) * (x - i);
+	}
+
+	return z < 0 ? 1.0f - y : y;
+}
+
+float tanh_lut(float z) {
+	return 2.0f * sigmoid_lut(2.0f * z) - 1.0f;
+}
+
+float mlp_sigmoid(MLPActivation activation, float z) {
+	switch(activation) {
+		case MLP_ACTIVATION_PWL: return sigmoid_pwl(z);
+		case MLP_ACTIVATION_LUT: return sigmoid_lut(z);
+		default: return sigmoid(z);
+	}
+}
+
+float mlp_tanh(MLPActivation activation, float z) {
+	switch(activation) {
+		case MLP_ACTIVATION_PWL: return tanh_pwl(z);
+		case MLP_ACTIVATION_LUT: return tanh_lut(z);
+		default: return tanhyper(z);
+	}
+}
+
 float d_identity(float z) {
 	return 1.0;
 }
@@ -29,34 +148,43 @@ float d_tanhyper(float z) {
 	return 1.0 - z * z;
 }
 
-void model(MLP* mlp, int input_layer_length, int hidden_layer_length, int output_layer_length, int max_epochs, float learning_rate, float threshold) {
+void init_weights(MLP* mlp, unsigned int seed) {
+	srand(seed);
+
+	for(int i = 0; i < mlp->hidden_layer_length; i++) {
+		for(int j = 0; j < (mlp->input_layer_length + 1); j++) {
+			mlp->hidden_layer_weights[i][j] = 2.0f * ((float)rand() / (2.0f * (float)RAND_MAX)) - 0.5f;
+		}
+	}
+
+	for(int i = 0; i < mlp->output_layer_length; i++) {
+		for(int j = 0; j < (mlp->hidden_layer_length + 1); j++) {
+			mlp->output_layer_weights[i][j] = 2.0f * ((float)rand() / (2.0f * (float)RAND_MAX)) - 0.5f;
+		}
+	}
+}
+
+void model(MLP* mlp, int input_layer_length, int hidden_layer_length, int output_layer_length, MLPActivation activation, int max_epochs, float learning_rate, float threshold) {
 	mlp->input_layer_length = input_layer_length;
 	mlp->hidden_layer_length = hidden_layer_length;
 	mlp->output_layer_length = output_layer_length;
+	mlp->activation = activation;
 	mlp->max_epochs = max_epochs;
 	mlp->learning_rate = learning_rate;
 	mlp->threshold = threshold;
 
-	srand(time(0));
-
 	mlp->hidden_layer_weights = malloc(hidden_layer_length * sizeof(float*));
-
 	for(int i = 0; i < hidden_layer_length; i++) {
 		mlp->hidden_layer_weights[i] = malloc((input_layer_length + 1) * sizeof(float));
-		for(int j = 0; j < (input_layer_length + 1); j++) {
-			mlp->hidden_layer_weights[i][j] = 2.0f * ((float)rand() / (2.0f * (float)RAND_MAX)) - 0.5f;
-		}
 	}
 
 	mlp->output_layer_weights = malloc(output_layer_length * sizeof(float*));
-
 	for(int i = 0; i < output_layer_length; i++) {
 		mlp->output_layer_weights[i] = malloc((hidden_layer_length + 1) * sizeof(float));
-		for(int j = 0; j < (hidden_layer_length + 1); j++) {
-			mlp->output_layer_weights[i][j] = 2.0f * ((float)rand() / (2.0f * (float)RAND_MAX)) - 0.5f;
-		}
 	}
 
+	init_weights(mlp, time(0));
+
 	mlp->hidden_layer_outputs = malloc(hidden_layer_length * sizeof(float));
 	mlp->output_layer_outputs = malloc(output_layer_length * sizeof(float));
 }
@@ -70,7 +198,7 @@ void forward(MLP* mlp, float* X) {
 			hidden_layer_net += mlp->hidden_layer_weights[i][j] * X[j];
 		}
 		hidden_layer_net += mlp->hidden_layer_weights[i][mlp->input_layer_length];
-		mlp->hidden_layer_outputs[i] = sigmoid(hidden_layer_net);
+		mlp->hidden_layer_outputs[i] = mlp_sigmoid(mlp->activation, hidden_layer_net);
 	}
 
 	for(int i = 0; i < mlp->output_layer_length ; i++) {
@@ -79,8 +207,225 @@ void forward(MLP* mlp, float* X) {
 			output_layer_net += mlp->output_layer_weights[i][j] * mlp->hidden_layer_outputs[j];
 		}
 		output_layer_net += mlp->output_layer_weights[i][mlp->hidden_layer_length];
-		mlp->output_layer_outputs[i] = sigmoid(output_layer_net);
+		mlp->output_layer_outputs[i] = mlp_sigmoid(mlp->activation, output_layer_net);
+	}
+}
+
+void forward_const(const MLPConst* mlp, const float* X, float* hidden_layer_outputs, float* output_layer_outputs) {
+	const float *w = mlp->weights;
+	float net;
+
+	for(int i = 0; i < mlp->hidden_layer_length; i++) {
+		net = 0;
+		for(int j = 0; j < mlp->input_layer_length; j++) {
+			net += *w++ * X[j];
+		}
+		net += *w++;
+		hidden_layer_outputs[i] = mlp_sigmoid(mlp->activation, net);
+	}
+
+	for(int i = 0; i < mlp->output_layer_length; i++) {
+		net = 0;
+		for(int j = 0; j < mlp->hidden_layer_length; j++) {
+			net += *w++ * hidden_layer_outputs[j];
+		}
+		net += *w++;
+		output_layer_outputs[i] = mlp_sigmoid(mlp->activation, net);
+	}
+}
+
+// Uma camada em lote: out[i][s] = f(sum_j w[i][j] * in[j][s] + bias[i]), somando na mesma
+// ordem de forward_const para que os resultados sejam idênticos
+static const float* layer_batch(const float* w, const float* restrict in, float* restrict out, int inputs, int outputs, int samples, MLPActivation activation) {
+	for(int i = 0; i < outputs; i++) {
+		float *restrict net = out + i * samples;
+
+		for(int s = 0; s < samples; s++) net[s] = 0;
+		for(int j = 0; j < inputs; j++) {
+			const float wij = *w++;
+			const float *restrict x = in + j * samples;
+			for(int s = 0; s < samples; s++) net[s] += wij * x[s];
+		}
+		const float bias = *w++;
+		for(int s = 0; s < samples; s++) net[s] += bias;
+
+		// Escolha da ativação fora do laço, para que cada variante seja inlinada
+		switch(activation) {
+			case MLP_ACTIVATION_PWL: for(int s = 0; s < samples; s++) net[s] = sigmoid_pwl(net[s]); break;
+			case MLP_ACTIVATION_LUT: for(int s = 0; s < samples; s++) net[s] = sigmoid_lut(net[s]); break;
+			default: for(int s = 0; s < samples; s++) net[s] = sigmoid(net[s]); break;
+		}
+	}
+	return w;
+}
+
+void forward_batch(const MLPConst* mlp, const float* X, float* hidden_layer_outputs, float* output_layer_outputs, int samples) {
+	const float *w = mlp->weights;
+
+	w = layer_batch(w, X, hidden_layer_outputs, mlp->input_layer_length, mlp->hidden_layer_length, samples, mlp->activation);
+	layer_batch(w, hidden_layer_outputs, output_layer_outputs, mlp->hidden_layer_length, mlp->output_layer_length, samples, mlp->activation);
+}
+
+void export_weights(const MLP* mlp, float* weights) {
+	for(int i = 0; i < mlp->hidden_layer_length; i++) {
+		for(int j = 0; j < (mlp->input_layer_length + 1); j++) {
+			*weights++ = mlp->hidden_layer_weights[i][j];
+		}
+	}
+	for(int i = 0; i < mlp->output_layer_length; i++) {
+		for(int j = 0; j < (mlp->hidden_layer_length + 1); j++) {
+			*weights++ = mlp->output_layer_weights[i][j];
+		}
+	}
+}
+
+void import_weights(MLP* mlp, const float* weights) {
+	for(int i = 0; i < mlp->hidden_layer_length; i++) {
+		for(int j = 0; j < (mlp->input_layer_length + 1); j++) {
+			mlp->hidden_layer_weights[i][j] = *weights++;
+		}
+	}
+	for(int i = 0; i < mlp->output_layer_length; i++) {
+		for(int j = 0; j < (mlp->hidden_layer_length + 1); j++) {
+			mlp->output_layer_weights[i][j] = *weights++;
+		}
+	}
+}
+
+float accumulate_gradients(const MLPConst* mlp, const float* X, const float* Y, float* grad, float* hidden_layer_outputs, float* output_layer_outputs) {
+	int hidden_row = mlp->input_layer_length + 1, output_row = mlp->hidden_layer_length + 1;
+	const float *output_weights = mlp->weights + mlp->hidden_layer_length * hidden_row;
+	float *grad_hidden = grad, *grad_output = grad + mlp->hidden_layer_length * hidden_row;
+	float delta_output[mlp->output_layer_length];
+	float quad_error = 0;
+
+	forward_const(mlp, X, hidden_layer_outputs, output_layer_outputs);
+
+	// Erro e delta de cada saída calculados uma única vez por amostra
+	for(int k = 0; k < mlp->output_layer_length; k++) {
+		float error = Y[k] - output_layer_outputs[k];
+		quad_error += error * error;
+		delta_output[k] = -2 * error * d_sigmoid(output_layer_outputs[k]);
+
+		for(int j = 0; j < mlp->hidden_layer_length; j++) {
+			grad_output[k * output_row + j] += delta_output[k] * hidden_layer_outputs[j];
+		}
+		grad_output[k * output_row + mlp->hidden_layer_length] += delta_output[k];
 	}
+
+	for(int j = 0; j < mlp->hidden_layer_length; j++) {
+		float sum = 0;
+		for(int k = 0; k < mlp->output_layer_length; k++) {
+			sum += delta_output[k] * output_weights[k * output_row + j];
+		}
+		float delta_hidden = sum * d_sigmoid(hidden_layer_outputs[j]);
+
+		for(int i = 0; i < mlp->input_layer_length; i++) {
+			grad_hidden[j * hidden_row + i] += delta_hidden * X[i];
+		}
+		grad_hidden[j * hidden_row + mlp->input_layer_length] += delta_hidden;
+	}
+
+	return quad_error;
+}
+
+// Sigmoid em ponto fixo: tabela de 0 a 8 com passo 0,25 em Q15, interpolação linear
+// e simetria sigmoid(-z) = 1 - sigmoid(z)
+static const uint16_t sigmoid_q15_table[33] = {
+	16384, 18421, 20397, 22255, 23955, 25471, 26790, 27917, 28862, 29644, 30282,
+	30799, 31214, 31545, 31807, 32015, 32179, 32307, 32408, 32487, 32549, 32597,
+	32635, 32664, 32687, 32705, 32719, 32730, 32738, 32745, 32750, 32754, 32757
+};
+
+static int16_t sigmoid_q15(int32_t z_q12) {
+	int32_t a = z_q12 < 0 ? -z_q12 : z_q12;
+	int32_t y;
+
+	if(a >= (8 << 12)) {
+		y = sigmoid_q15_table[32];
+	} else {
+		int i = a >> 10;
+		int32_t f = a & 1023;
+		y = sigmoid_q15_table[i] + (((sigmoid_q15_table[i + 1] - sigmoid_q15_table[i]) * f) >> 10);
+	}
+
+	return (int16_t)(z_q12 < 0 ? MLP_Q15_ONE - y : y);
+}
+
+// Acumulador (pesos int8 x ativações Q15) para o net da camada em Q12
+static int32_t scale_net(int32_t acc, MLPQ8Scale scale) {
+	return (int32_t)(((int64_t)acc * scale.multiplier + ((int64_t)1 << (scale.shift - 1))) >> scale.shift);
+}
+
+void forward_q8(const MLPQ8* mlp, const int16_t* X, int16_t* hidden_layer_outputs, int16_t* output_layer_outputs) {
+	const int8_t *w = mlp->weights;
+	const int32_t *b = mlp->biases;
+	int32_t acc;
+
+	for(int i = 0; i < mlp->hidden_layer_length; i++) {
+		acc = *b++;
+		for(int j = 0; j < mlp->input_layer_length; j++) {
+			acc += *w++ * X[j];
+		}
+		hidden_layer_outputs[i] = sigmoid_q15(scale_net(acc, mlp->hidden_scale));
+	}
+
+	for(int i = 0; i < mlp->output_layer_length; i++) {
+		acc = *b++;
+		for(int j = 0; j < mlp->hidden_layer_length; j++) {
+			acc += *w++ * hidden_layer_outputs[j];
+		}
+		output_layer_outputs[i] = sigmoid_q15(scale_net(acc, mlp->output_scale));
+	}
+}
+
+// Quantiza uma camada (linhas de cols pesos + bias) com escala simétrica por camada:
+// peso ~ w_q * s, com s = max|peso| / 127, e bias levado à escala do acumulador (s / 2^15)
+static MLPQ8Scale quantize_layer(const float* src, int rows, int cols, int8_t* weights, int32_t* biases) {
+	float max_abs = 0;
+	MLPQ8Scale scale;
+	int exponent;
+
+	for(int i = 0; i < rows; i++) {
+		for(int j = 0; j < cols; j++) {
+			float a = fabsf(src[i * (cols + 1) + j]);
+			if(a > max_abs) max_abs = a;
+		}
+	}
+	if(max_abs == 0) max_abs = 1;
+
+	double s = max_abs / 127.0;
+	for(int i = 0; i < rows; i++) {
+		for(int j = 0; j < cols; j++) {
+			long q = lround(src[i * (cols + 1) + j] / s);
+			*weights++ = (int8_t)(q > 127 ? 127 : (q < -127 ? -127 : q));
+		}
+		*biases++ = (int32_t)lround(src[i * (cols + 1) + cols] * (double)MLP_Q15_ONE / s);
+	}
+
+	// net Q12 = acc * s / 2^15 * 2^12 = acc * (s / 8), representado como multiplier * 2^-shift
+	double m = frexp(s / 8.0, &exponent);
+	scale.multiplier = (int32_t)lround(m * 32768.0);
+	scale.shift = 15 - exponent;
+	if(scale.multiplier == 32768) {
+		scale.multiplier = 16384;
+		scale.shift--;
+	}
+	return scale;
+}
+
+void quantize_mlp(const MLPConst* src, MLPQ8* dst, int8_t* weights, int32_t* biases) {
+	dst->input_layer_length = src->input_layer_length;
+	dst->hidden_layer_length = src->hidden_layer_length;
+	dst->output_layer_length = src->output_layer_length;
+	dst->weights = weights;
+	dst->biases = biases;
+
+	dst->hidden_scale = quantize_layer(src->weights, src->hidden_layer_length, src->input_layer_length, weights, biases);
+	dst->output_scale = quantize_layer(src->weights + src->hidden_layer_length * (src->input_layer_length + 1),
+	                                   src->output_layer_length, src->hidden_layer_length,
+	                                   weights + src->hidden_layer_length * src->input_layer_length,
+	                                   biases + src->hidden_layer_length);
 }
 
 void backpropagation(MLP* mlp, float** X, float** Y, int samples) {
@@ -0,0 +1,96 @@
+#include "profile.h"
+
+#if PROFILE_ENABLED
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+
+#if !PICO_ON_DEVICE
+#include <time.h>
+#endif
+
+static const char* const stage_names[PROFILE_STAGES] = {
+    [PROFILE_BH1750_READ] = "bh1750_read",
+    [PROFILE_GY33_READ] = "gy33_read",
+    [PROFILE_HSV] = "rgb_to_hsv",
+    [PROFILE_MLP] = "ambient_mode",
+    [PROFILE_OLED_DRAW] = "oled_draw",
+    [PROFILE_OLED_SEND] = "oled_send",
+    [PROFILE_LEDS] = "np_set_leds",
+};
+
+static profile_stage_t stages[PROFILE_STAGES];
+
+/**
+ * @brief Relógio do perfil em ns, com volta a cada ~4,3 s: as diferenças continuam
+ * corretas para etapas mais curtas que isso.
+ */
+uint32_t profile_now_ns(void) {
+#if PICO_ON_DEVICE
+    return time_us_32() * 1000u;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+#endif
+}
+
+/**
+ * @brief Registra uma execução da etapa.
+ * @param stage Etapa.
+ * @param elapsed_ns Duração.
+ */
+void profile_record(profile_stage_id_t stage, uint32_t elapsed_ns) {
+    profile_stage_t* s = &stages[stage];
+    uint bucket = elapsed_ns ? 31 - __builtin_clz(elapsed_ns) : 0;
+
+    s->count++;
+    s->total_ns += elapsed_ns;
+    if (elapsed_ns > s->max_ns) s->max_ns = elapsed_ns;
+    s->buckets[bucket]++;
+}
+
+/**
+ * @brief Zera os contadores de todas as etapas.
+ */
+void profile_reset(void) {
+    memset(stages, 0, sizeof(stages));
+}
+
+/**
+ * @brief Estatísticas acumuladas de uma etapa.
+ */
+const profile_stage_t* profile_stage(profile_stage_id_t stage) {
+    return &stages[stage];
+}
+
+// Limite de balde em ns, us ou ms, para o histograma caber em uma linha
+static void print_bound(uint32_t ns) {
+    if (ns >= 1000000) printf("%lums", (unsigned long)(ns / 1000000));
+    else if (ns >= 1000) printf("%luus", (unsigned long)(ns / 1000));
+    else printf("%luns", (unsigned long)ns);
+}
+
+/**
+ * @brief Imprime no stdio, por etapa: execuções, média, máximo e os baldes não vazios do
+ * histograma como "<limite superior>:contagem".
+ */
+void profile_dump(void) {
+    printf("perfil (ns): etapa execucoes media maximo | histograma\n");
+    for (uint i = 0; i < PROFILE_STAGES; i++) {
+        const profile_stage_t* s = &stages[i];
+        if (!s->count) continue;
+        printf("%-13s %8lu %10lu %10lu |", stage_names[i], (unsigned long)s->count,
+               (unsigned long)(s->total_ns / s->count), (unsigned long)s->max_ns);
+        for (uint b = 0; b < PROFILE_BUCKETS; b++) {
+            if (!s->buckets[b]) continue;
+            printf(" <");
+            print_bound(b == 31 ? UINT32_MAX : 2u << b);
+            printf(":%lu", (unsigned long)s->buckets[b]);
+        }
+        printf("\n");
+    }
+}
+
+#endif // PROFILE_ENABLED
@@ -0,0 +1,345 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include "runtime_config.h"
+#include "telemetry.h"
+#include "config.h"
+
+#define RUNTIME_CONFIG_DEFAULT {                                  \
+    .luminosity_threshold = LUMINOSITY_THRESHOLD,                 \
+    .luminosity_max = LUMINOSITY_MAX,                             \
+    .color_max_value = SENSOR_COLOR_MAX_VALUE,                    \
+    .mode_lux = {{RELAX_LUX_MIN, RELAX_LUX_MAX},                  \
+                 {WORK_LUX_MIN, WORK_LUX_MAX},                    \
+                 {PARTY_LUX_MIN, PARTY_LUX_MAX}},                 \
+    .cor = LIMIARES_COR_PADRAO,                                   \
+}
+
+// Registro arredondado para páginas inteiras, a unidade de gravação da flash
+#define RECORD_PROGRAM_LEN \
+    ((RUNTIME_CONFIG_RECORD_LEN + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE * FLASH_PAGE_SIZE)
+
+runtime_config_t runtime_config = RUNTIME_CONFIG_DEFAULT;
+const runtime_config_t runtime_config_default = RUNTIME_CONFIG_DEFAULT;
+
+static int current_slot = -1;  // Setor com a configuração gravada mais recente (-1: nenhum)
+static uint32_t current_seq;
+
+// Troca entre os núcleos: o núcleo 1 edita staged e copia para published; o núcleo 0 copia
+// published para runtime_config. Como no sample_ring, cada contador só é escrito por um núcleo.
+static runtime_config_t staged;
+static runtime_config_t published;
+static volatile uint32_t publish_count;
+static volatile uint32_t sync_count;
+
+typedef struct {
+    uint32_t offset;
+    const uint8_t* data;
+} config_write_t;
+
+// Campos ajustáveis por "cfg set"
+typedef struct {
+    const char* name;
+    uint16_t offset;
+    uint8_t size;
+} config_key_t;
+
+#define KEY(name, field) {name, offsetof(runtime_config_t, field), sizeof(((runtime_config_t*)0)->field)}
+
+static const config_key_t keys[] = {
+    KEY("lux_min", luminosity_threshold),
+    KEY("lux_max", luminosity_max),
+    KEY("color_max", color_max_value),
+    KEY("relax_lux_min", mode_lux[0][0]),
+    KEY("relax_lux_max", mode_lux[0][1]),
+    KEY("work_lux_min", mode_lux[1][0]),
+    KEY("work_lux_max", mode_lux[1][1]),
+    KEY("party_lux_min", mode_lux[2][0]),
+    KEY("party_lux_max", mode_lux[2][1]),
+    KEY("v_min", cor.v_min),
+    KEY("branco_s_max", cor.branco_s_max),
+    KEY("branco_v_min", cor.branco_v_min),
+    KEY("intensa_s_min", cor.intensa_s_min),
+    KEY("intensa_v_min", cor.intensa_v_min),
+};
+#define KEYS_COUNT (sizeof(keys) / sizeof(keys[0]))
+
+static const uint8_t* slot_in_flash(int slot) {
+    return (const uint8_t*)(XIP_BASE + FLASH_CONFIG_OFFSET + slot * FLASH_SECTOR_SIZE);
+}
+
+// CRC dos 10 primeiros bytes do cabeçalho seguidos da configuração
+static uint16_t record_crc(const uint8_t* r) {
+    uint8_t buf[10 + sizeof(runtime_config_t)];
+    memcpy(buf, r, 10);
+    memcpy(buf + 10, r + RUNTIME_CONFIG_HEADER_LEN, sizeof(runtime_config_t));
+    return telemetry_crc16(buf, sizeof(buf));
+}
+
+static void encode_record(const runtime_config_t* config, uint32_t seq, uint8_t* out) {
+    out[0] = (uint8_t)RUNTIME_CONFIG_MAGIC;
+    out[1] = (uint8_t)(RUNTIME_CONFIG_MAGIC >> 8);
+    out[2] = RUNTIME_CONFIG_VERSION;
+    out[3] = 0;
+    out[4] = (uint8_t)sizeof(runtime_config_t);
+    out[5] = (uint8_t)(sizeof(runtime_config_t) >> 8);
+    out[6] = (uint8_t)seq;
+    out[7] = (uint8_t)(seq >> 8);
+    out[8] = (uint8_t)(seq >> 16);
+    out[9] = (uint8_t)(seq >> 24);
+    memcpy(out + RUNTIME_CONFIG_HEADER_LEN, config, sizeof(runtime_config_t));
+    uint16_t crc = record_crc(out);
+    out[10] = (uint8_t)crc;
+    out[11] = (uint8_t)(crc >> 8);
+}
+
+/**
+ * @brief Confere se os valores não quebram o caminho quente (map divide por max - min) e
+ * estão nas faixas das comparações.
+ * @param config Configuração.
+ * @return true se a configuração pode ser usada.
+ */
+bool runtime_config_valid(const runtime_config_t* config) {
+    const LimiaresCor* cor = &config->cor;
+
+    if (config->color_max_value == 0 || config->luminosity_max <= config->luminosity_threshold) return false;
+    for (int i = 0; i < AMBIENT_OUTPUT_LEN; i++) {
+        if (config->mode_lux[i][0] > config->mode_lux[i][1]) return false;
+    }
+    if (cor->v_min > 100 || cor->branco_s_max > 100 || cor->branco_v_min > 100 || cor->intensa_s_min > 100 ||
+        cor->intensa_v_min > 100) {
+        return false;
+    }
+    for (int h = 0; h < 360; h++) {
+        if (cor->cor_por_grau[h] > MAGENTA) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Confere magic, versão, tamanho, CRC e valores de um registro de configuração.
+ * @param record Registro.
+ * @param len Bytes disponíveis em record.
+ * @param config Configuração decodificada, se válida.
+ * @param seq Sequência do registro (pode ser NULL).
+ * @return true se o registro é válido.
+ */
+bool runtime_config_decode(const uint8_t* record, size_t len, runtime_config_t* config, uint32_t* seq) {
+    runtime_config_t decoded;
+
+    if (len < RUNTIME_CONFIG_RECORD_LEN) return false;
+    if ((record[0] | (record[1] << 8)) != RUNTIME_CONFIG_MAGIC || record[2] != RUNTIME_CONFIG_VERSION) return false;
+    if ((record[4] | (record[5] << 8)) != sizeof(runtime_config_t)) return false;
+    if ((record[10] | (record[11] << 8)) != record_crc(record)) return false;
+
+    memcpy(&decoded, record + RUNTIME_CONFIG_HEADER_LEN, sizeof(decoded));
+    if (!runtime_config_valid(&decoded)) return false;
+    *config = decoded;
+    if (seq) *seq = record[6] | (record[7] << 8) | (record[8] << 16) | ((uint32_t)record[9] << 24);
+    return true;
+}
+
+/**
+ * @brief Carrega a configuração válida de maior sequência dos dois setores; sem nenhuma,
+ * fica a padrão. Chamada no boot, antes do núcleo 1 começar.
+ * @return true se veio da flash.
+ */
+bool runtime_config_load(void) {
+    runtime_config_t config;
+    uint32_t seq;
+
+    runtime_config = runtime_config_default;
+    current_slot = -1;
+    current_seq = 0;
+    for (int slot = 0; slot < 2; slot++) {
+        if (runtime_config_decode(slot_in_flash(slot), RUNTIME_CONFIG_RECORD_LEN, &config, &seq) &&
+            (current_slot < 0 || (int32_t)(seq - current_seq) > 0)) {
+            runtime_config = config;
+            current_slot = slot;
+            current_seq = seq;
+        }
+    }
+
+    staged = published = runtime_config;
+    publish_count = sync_count = 0;
+    return current_slot >= 0;
+}
+
+// Roda com o outro núcleo pausado e as interrupções desligadas (flash_safe_execute)
+static void config_write(void* param) {
+    const config_write_t* w = param;
+    flash_range_erase(w->offset, FLASH_SECTOR_SIZE);
+    flash_range_program(w->offset, w->data, RECORD_PROGRAM_LEN);
+}
+
+/**
+ * @brief Grava a configuração no setor que não tem a atual, com a sequência seguinte, e
+ * confere a leitura. A configuração anterior só deixa de valer quando a nova está completa.
+ * @param config Configuração a gravar.
+ * @return true se a gravação foi conferida.
+ */
+bool runtime_config_save(const runtime_config_t* config) {
+    static uint8_t record[RECORD_PROGRAM_LEN];
+    runtime_config_t check;
+    int slot = current_slot == 0 ? 1 : 0;
+    uint32_t seq = current_seq + 1;
+
+    if (!runtime_config_valid(config)) return false;
+
+    memset(record, 0xFF, sizeof(record));
+    encode_record(config, seq, record);
+    config_write_t w = {FLASH_CONFIG_OFFSET + slot * FLASH_SECTOR_SIZE, record};
+    if (flash_safe_execute(config_write, &w, UINT32_MAX) != PICO_OK) return false;
+
+    if (!runtime_config_decode(slot_in_flash(slot), RUNTIME_CONFIG_RECORD_LEN, &check, NULL) ||
+        memcmp(&check, config, sizeof(check))) {
+        return false;
+    }
+    current_slot = slot;
+    current_seq = seq;
+    return true;
+}
+
+/**
+ * @brief Envia a configuração publicada (a que o núcleo 0 usa) como um quadro COBS.
+ * @param put Saída de um byte (putchar_raw na USB).
+ */
+void runtime_config_dump(int (*put)(int c)) {
+    uint8_t record[RUNTIME_CONFIG_RECORD_LEN];
+    uint8_t frame[COBS_MAX_ENCODED_LEN(RUNTIME_CONFIG_RECORD_LEN)];
+
+    encode_record(&published, current_seq, record);
+    size_t n = cobs_encode(record, sizeof(record), frame);
+    put(0);
+    for (size_t i = 0; i < n; i++) put(frame[i]);
+    put(0);
+}
+
+/**
+ * @brief Adota a configuração publicada pelo núcleo 1. Chamada pelo núcleo 0 antes de
+ * cada amostra; sem publicação nova, custa uma comparação.
+ */
+void runtime_config_sync(void) {
+    uint32_t count = publish_count;
+
+    if (count == sync_count) return;
+    __dmb(); // Lê published só depois de ver o contador
+    runtime_config = published;
+    __dmb(); // Termina a cópia antes de liberar published para o núcleo 1
+    sync_count = count;
+}
+
+static void print_config(const runtime_config_t* config) {
+    for (uint i = 0; i < KEYS_COUNT; i++) {
+        const uint8_t* p = (const uint8_t*)config + keys[i].offset;
+        printf("%s %u\n", keys[i].name, keys[i].size == 2 ? (unsigned)(p[0] | (p[1] << 8)) : p[0]);
+    }
+
+    // Faixas de Hue no formato de "cfg hue": cor, início e fim (exclusivo)
+    for (int start = 0, h = 1; h <= 360; h++) {
+        if (h < 360 && config->cor.cor_por_grau[h] == config->cor.cor_por_grau[start]) continue;
+        if (config->cor.cor_por_grau[start] != INDEFINIDO) {
+            printf("hue %s %d %d\n", obter_nome_para_cor((CorIdentificada)config->cor.cor_por_grau[start]), start, h);
+        }
+        start = h;
+    }
+}
+
+static bool set_key(const char* name, const char* value) {
+    char* end;
+    unsigned long v = strtoul(value, &end, 10);
+
+    for (uint i = 0; i < KEYS_COUNT; i++) {
+        if (strcmp(name, keys[i].name)) continue;
+        if (*value == '\0' || *end != '\0' || v > (keys[i].size == 2 ? 0xFFFFu : 0xFFu)) {
+            printf("cfg: valor invalido para %s\n", name);
+            return false;
+        }
+        uint8_t* p = (uint8_t*)&staged + keys[i].offset;
+        p[0] = (uint8_t)v;
+        if (keys[i].size == 2) p[1] = (uint8_t)(v >> 8);
+        return true;
+    }
+    printf("cfg: chave desconhecida %s\n", name);
+    return false;
+}
+
+// Pinta os graus [start, end) com a cor; start > end dá a volta em 360
+static bool set_hue(const char* name, unsigned start, unsigned end) {
+    int cor = -1;
+
+    for (int c = INDEFINIDO; c <= MAGENTA; c++) {
+        if (!strcasecmp(name, obter_nome_para_cor((CorIdentificada)c))) cor = c;
+    }
+    if (cor < 0 || start >= 360 || end > 360) {
+        printf("cfg: uso: cfg hue <cor> <inicio 0..359> <fim 0..360>\n");
+        return false;
+    }
+    for (unsigned h = start; h != end; h = (h + 1) % 360) {
+        staged.cor.cor_por_grau[h] = (uint8_t)cor;
+        if (h + 1 == end) break; // end == 360
+    }
+    return true;
+}
+
+/**
+ * @brief Executa uma linha do console. Comandos:
+ * cfg [show] | cfg set <chave> <valor> | cfg hue <cor> <inicio> <fim> | cfg defaults |
+ * cfg revert | cfg apply | cfg save | cfg help
+ * @param line Linha sem o fim de linha.
+ * @return true se o comando foi aceito.
+ */
+bool runtime_config_command(const char* line) {
+    char cmd[12] = "show", arg[20] = "", value[12] = "";
+    unsigned start, end;
+
+    if (strncmp(line, "cfg", 3) || (line[3] != '\0' && line[3] != ' ')) {
+        printf("comando desconhecido: %s (d, p, r ou cfg help)\n", line);
+        return false;
+    }
+    int n = sscanf(line + 3, "%11s %19s %11s", cmd, arg, value);
+
+    if (!strcmp(cmd, "show")) {
+        print_config(&staged);
+        if (memcmp(&staged, &published, sizeof(staged))) printf("(alteracoes pendentes: cfg apply ou cfg save)\n");
+        return true;
+    }
+    if (!strcmp(cmd, "set") && n == 3) return set_key(arg, value);
+    if (!strcmp(cmd, "hue") && sscanf(line + 3, "%*s %*s %u %u", &start, &end) == 2) return set_hue(arg, start, end);
+    if (!strcmp(cmd, "defaults")) {
+        staged = runtime_config_default;
+        return true;
+    }
+    if (!strcmp(cmd, "revert")) {
+        staged = published;
+        return true;
+    }
+    if (!strcmp(cmd, "apply") || !strcmp(cmd, "save")) {
+        bool save = cmd[0] == 's';
+        if (!runtime_config_valid(&staged)) {
+            printf("cfg: configuracao invalida (lux_max > lux_min, color_max > 0, faixas min <= max, %% <= 100)\n");
+            return false;
+        }
+        if (publish_count != sync_count) {
+            printf("cfg: a configuracao anterior ainda nao foi adotada, tente de novo\n");
+            return false;
+        }
+        if (save && !runtime_config_save(&staged)) {
+            printf("cfg: falha ao gravar na flash\n");
+            return false;
+        }
+        published = staged;
+        __dmb(); // Publica o contador só depois da cópia
+        publish_count++;
+        printf("cfg: %s\n", save ? "gravada" : "aplicada sem gravar");
+        return true;
+    }
+
+    printf("cfg show | set <chave> <valor> | hue <cor> <inicio> <fim> | defaults | revert | apply | save\n");
+    return !strcmp(cmd, "help");
+}
@@ -0,0 +1,51 @@
+#include "sample_ring.h"
+#include "hardware/sync.h"
+
+/**
+ * @brief Esvazia a fila.
+ * @param ring Fila a inicializar.
+ */
+void sample_ring_init(sample_ring_t* ring) {
+    ring->head = 0;
+    ring->tail = 0;
+    ring->dropped = 0;
+}
+
+/**
+ * @brief Enfileira uma amostra (lado do produtor).
+ * O slot é preenchido antes de publicar o novo head; a barreira garante que o outro
+ * núcleo nunca veja o índice antes dos dados. O __sev acorda o consumidor em __wfe.
+ * @param ring Fila.
+ * @param sample Amostra a copiar.
+ * @return false se a fila estava cheia e a amostra foi descartada.
+ */
+bool sample_ring_push(sample_ring_t* ring, const sample_record_t* sample) {
+    uint32_t head = ring->head;
+
+    if (head - ring->tail == SAMPLE_RING_SIZE) {
+        ring->dropped++;
+        return false;
+    }
+    ring->slots[head % SAMPLE_RING_SIZE] = *sample;
+    __dmb();
+    ring->head = head + 1;
+    __sev();
+    return true;
+}
+
+/**
+ * @brief Desenfileira a amostra mais antiga (lado do consumidor).
+ * @param ring Fila.
+ * @param sample Destino da cópia.
+ * @return false se não havia amostra.
+ */
+bool sample_ring_pop(sample_ring_t* ring, sample_record_t* sample) {
+    uint32_t tail = ring->tail;
+
+    if (tail == ring->head) return false;
+    __dmb(); // Lê o slot só depois de ver o head publicado
+    *sample = ring->slots[tail % SAMPLE_RING_SIZE];
+    __dmb(); // Termina a cópia antes de liberar o slot para o produtor
+    ring->tail = tail + 1;
+    return true;
+}
@@ -0,0 +1,70 @@
+#include "scheduler.h"
+
+/**
+ * @brief Libera todas as tarefas para rodar imediatamente e zera os contadores.
+ * @param tasks Tabela de tarefas.
+ * @param count Número de tarefas.
+ */
+void scheduler_start(task_t* tasks, uint count) {
+    absolute_time_t now = get_absolute_time();
+    for (uint i = 0; i < count; i++) {
+        tasks[i].next_deadline = now;
+        tasks[i].runs = 0;
+        tasks[i].overruns = 0;
+    }
+}
+
+/**
+ * @brief Roda as tarefas vencidas, a de prazo mais antigo primeiro, até não restar nenhuma.
+ * Se uma tarefa só termina depois do prazo seguinte, conta um overrun e o prazo é
+ * reancorado no instante atual, em vez de disparar as execuções perdidas em rajada.
+ * @param tasks Tabela de tarefas.
+ * @param count Número de tarefas.
+ */
+void scheduler_run_pending(task_t* tasks, uint count) {
+    while (1) {
+        absolute_time_t now = get_absolute_time();
+        task_t* due = NULL;
+
+        for (uint i = 0; i < count; i++) {
+            if (absolute_time_diff_us(now, tasks[i].next_deadline) <= 0 &&
+                (!due || absolute_time_diff_us(due->next_deadline, tasks[i].next_deadline) < 0)) {
+                due = &tasks[i];
+            }
+        }
+        if (!due) return;
+
+        due->run();
+        due->runs++;
+
+        absolute_time_t next = delayed_by_us(due->next_deadline, due->period_us);
+        now = get_absolute_time();
+        if (absolute_time_diff_us(now, next) <= 0) {
+            due->overruns++;
+            next = delayed_by_us(now, due->period_us);
+        }
+        due->next_deadline = next;
+    }
+}
+
+/**
+ * @brief Prazo mais próximo entre as tarefas.
+ * @param tasks Tabela de tarefas.
+ * @param count Número de tarefas.
+ */
+absolute_time_t scheduler_next_deadline(const task_t* tasks, uint count) {
+    absolute_time_t next = tasks[0].next_deadline;
+    for (uint i = 1; i < count; i++) {
+        if (absolute_time_diff_us(next, tasks[i].next_deadline) < 0) next = tasks[i].next_deadline;
+    }
+    return next;
+}
+
+/**
+ * @brief Dorme até o próximo prazo ou até um evento (__sev do outro núcleo, interrupção).
+ * @param tasks Tabela de tarefas.
+ * @param count Número de tarefas.
+ */
+void scheduler_idle(const task_t* tasks, uint count) {
+    best_effort_wfe_or_timeout(scheduler_next_deadline(tasks, count));
+}
@@ -0,0 +1,158 @@
+#include <string.h>
+#include "sensor_history.h"
+
+#define SLOT(seq) ((seq) % SENSOR_HISTORY_LEN)
+
+static uint16_t value_at(const sensor_history_t* h, uint32_t seq, sensor_channel_t ch) {
+    return h->samples[SLOT(seq)].value[ch];
+}
+
+// Primeira posição de sorted[0..n) com valor >= v
+static uint lower_bound(const uint16_t* sorted, uint n, uint16_t v) {
+    uint lo = 0, hi = n;
+    while (lo < hi) {
+        uint mid = (lo + hi) / 2;
+        if (sorted[mid] < v) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// Fila monotônica: descarta do fim os valores dominados pelo novo e o insere no fim.
+// Para o mínimo, dominado é >= v; para o máximo, <= v.
+static void monotonic_push(const sensor_history_t* h, sensor_channel_t ch, uint32_t* queue, uint8_t head,
+                           uint8_t* count, uint32_t seq, bool is_min) {
+    uint16_t v = value_at(h, seq, ch);
+    while (*count) {
+        uint16_t back = value_at(h, queue[(head + *count - 1) % SENSOR_HISTORY_LEN], ch);
+        if (is_min ? back < v : back > v) break;
+        (*count)--;
+    }
+    queue[(head + *count) % SENSOR_HISTORY_LEN] = seq;
+    (*count)++;
+}
+
+/**
+ * @brief Esvazia o histórico.
+ * @param h Histórico.
+ * @param ewma_shift Suavização da EWMA: alfa = 1 / 2^ewma_shift.
+ */
+void sensor_history_init(sensor_history_t* h, uint8_t ewma_shift) {
+    memset(h, 0, sizeof(*h));
+    h->ewma_shift = ewma_shift;
+}
+
+/**
+ * @brief Acrescenta uma leitura, descartando a mais antiga se a janela está cheia, e
+ * atualiza as estatísticas de todos os canais.
+ * @param h Histórico.
+ * @param timestamp_ms Instante da leitura.
+ * @param value Valor de cada canal (índices sensor_channel_t).
+ */
+void sensor_history_push(sensor_history_t* h, uint32_t timestamp_ms, const uint16_t value[SENSOR_CHANNELS]) {
+    uint32_t seq = h->pushed;
+    uint n = sensor_history_size(h);
+    bool full = n == SENSOR_HISTORY_LEN;
+
+    for (uint ch = 0; ch < SENSOR_CHANNELS; ch++) {
+        sensor_channel_stats_t* s = &h->channel[ch];
+        uint16_t v = value[ch];
+
+        // A amostra que sai da janela: tira da soma, da janela ordenada e das filas
+        if (full) {
+            uint16_t old = value_at(h, seq - SENSOR_HISTORY_LEN, ch);
+            uint i = lower_bound(s->sorted, n, old);
+            memmove(&s->sorted[i], &s->sorted[i + 1], (n - 1 - i) * sizeof(uint16_t));
+            s->sum -= old;
+            if (s->min_count && s->min_queue[s->min_head] == seq - SENSOR_HISTORY_LEN) {
+                s->min_head = (s->min_head + 1) % SENSOR_HISTORY_LEN;
+                s->min_count--;
+            }
+            if (s->max_count && s->max_queue[s->max_head] == seq - SENSOR_HISTORY_LEN) {
+                s->max_head = (s->max_head + 1) % SENSOR_HISTORY_LEN;
+                s->max_count--;
+            }
+        }
+
+        uint m = full ? n - 1 : n;
+        uint i = lower_bound(s->sorted, m, v);
+        memmove(&s->sorted[i + 1], &s->sorted[i], (m - i) * sizeof(uint16_t));
+        s->sorted[i] = v;
+        s->sum += v;
+
+        if (seq == 0) {
+            s->ewma_q8 = (uint32_t)v << 8;
+        } else {
+            int32_t diff = ((int32_t)v << 8) - (int32_t)s->ewma_q8;
+            s->ewma_q8 += diff >> h->ewma_shift;
+        }
+    }
+
+    h->samples[SLOT(seq)].timestamp_ms = timestamp_ms;
+    memcpy(h->samples[SLOT(seq)].value, value, sizeof(h->samples[0].value));
+    h->pushed = seq + 1;
+
+    for (uint ch = 0; ch < SENSOR_CHANNELS; ch++) {
+        sensor_channel_stats_t* s = &h->channel[ch];
+        monotonic_push(h, ch, s->min_queue, s->min_head, &s->min_count, seq, true);
+        monotonic_push(h, ch, s->max_queue, s->max_head, &s->max_count, seq, false);
+    }
+}
+
+/**
+ * @brief Número de leituras na janela (até SENSOR_HISTORY_LEN).
+ */
+uint sensor_history_size(const sensor_history_t* h) {
+    return h->pushed < SENSOR_HISTORY_LEN ? h->pushed : SENSOR_HISTORY_LEN;
+}
+
+/**
+ * @brief Leitura da janela pela idade.
+ * @param age 0 para a mais recente, até sensor_history_size() - 1.
+ * @return A leitura, ou NULL se não existe.
+ */
+const sensor_sample_t* sensor_history_get(const sensor_history_t* h, uint age) {
+    if (age >= sensor_history_size(h)) return NULL;
+    return &h->samples[SLOT(h->pushed - 1 - age)];
+}
+
+/**
+ * @brief Média da janela (arredondada); 0 com o histórico vazio.
+ */
+uint16_t sensor_history_mean(const sensor_history_t* h, sensor_channel_t ch) {
+    uint n = sensor_history_size(h);
+    return n ? (uint16_t)((h->channel[ch].sum + n / 2) / n) : 0;
+}
+
+/**
+ * @brief Média móvel exponencial (arredondada).
+ */
+uint16_t sensor_history_ewma(const sensor_history_t* h, sensor_channel_t ch) {
+    return (uint16_t)((h->channel[ch].ewma_q8 + 128) >> 8);
+}
+
+/**
+ * @brief Menor valor da janela; 0 com o histórico vazio.
+ */
+uint16_t sensor_history_min(const sensor_history_t* h, sensor_channel_t ch) {
+    const sensor_channel_stats_t* s = &h->channel[ch];
+    return s->min_count ? value_at(h, s->min_queue[s->min_head], ch) : 0;
+}
+
+/**
+ * @brief Maior valor da janela; 0 com o histórico vazio.
+ */
+uint16_t sensor_history_max(const sensor_history_t* h, sensor_channel_t ch) {
+    const sensor_channel_stats_t* s = &h->channel[ch];
+    return s->max_count ? value_at(h, s->max_queue[s->max_head], ch) : 0;
+}
+
+/**
+ * @brief Mediana da janela (média dos dois centrais com tamanho par); 0 com o histórico vazio.
+ */
+uint16_t sensor_history_median(const sensor_history_t* h, sensor_channel_t ch) {
+    uint n = sensor_history_size(h);
+    const uint16_t* sorted = h->channel[ch].sorted;
+    if (!n) return 0;
+    return (uint16_t)((sorted[(n - 1) / 2] + sorted[n / 2]) / 2);
+}
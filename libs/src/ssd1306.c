@@ -1,5 +1,38 @@
 #include "ssd1306.h"
 #include "font.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include <string.h>
+
+// Display que usa o canal DMA, para o handler de interrupção achar o callback
+static ssd1306_t *dma_owner = NULL;
+
+// Bytes no barramento para reposicionar a janela de colunas/páginas (controle + 6 comandos)
+#define SSD1306_WINDOW_COST 7
+
+// Palavras do buffer do DMA: quadro inteiro ou uma região por página, cada uma com sua janela
+#define SSD1306_DMA_WORDS(ssd) ((ssd)->bufsize + ((ssd)->pages + 1) * (SSD1306_WINDOW_COST + 1))
+
+typedef struct {
+  uint8_t col0, col1, page0, page1;
+} ssd1306_region_t;
+
+// Posição de (coluna, página) no ram_buffer, no modo de endereçamento vertical
+static inline uint16_t ssd1306_index(uint8_t x, uint8_t page) {
+  return (x << 3) + page + 1;
+}
+
+static inline void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t x, uint8_t page) {
+  if (x < ssd->dirty_min[page])
+    ssd->dirty_min[page] = x;
+  if (x > ssd->dirty_max[page])
+    ssd->dirty_max[page] = x;
+}
+
+static void ssd1306_clear_dirty(ssd1306_t *ssd) {
+  memset(ssd->dirty_min, 0xFF, sizeof(ssd->dirty_min));
+  memset(ssd->dirty_max, 0x00, sizeof(ssd->dirty_max));
+}
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
   ssd->width = width;
@@ -11,37 +44,38 @@ void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_v
   ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
   ssd->ram_buffer[0] = 0x40;
   ssd->port_buffer[0] = 0x80;
+  ssd->shadow = calloc(ssd->bufsize - 1, sizeof(uint8_t));
+  ssd->shadow_valid = false; // Conteúdo do display desconhecido: o primeiro envio é completo
+  ssd1306_clear_dirty(ssd);
+  ssd->dma_channel = -1;
+  ssd->dma_buffer = NULL;
+  ssd->flush_callback = NULL;
 }
 
 void ssd1306_config(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+  static const uint8_t init_sequence[] = {
+    SET_DISP | 0x00,
+    SET_MEM_ADDR, 0x01,
+    SET_DISP_START_LINE | 0x00,
+    SET_SEG_REMAP | 0x01,
+    SET_MUX_RATIO, HEIGHT - 1,
+    SET_COM_OUT_DIR | 0x08,
+    SET_DISP_OFFSET, 0x00,
+    SET_COM_PIN_CFG, 0x12,
+    SET_DISP_CLK_DIV, 0x80,
+    SET_PRECHARGE, 0xF1,
+    SET_VCOM_DESEL, 0x30,
+    SET_CONTRAST, 0xFF,
+    SET_ENTIRE_ON,
+    SET_NORM_INV,
+    SET_CHARGE_PUMP, 0x14,
+    SET_DISP | 0x01,
+  };
+  ssd1306_command_list(ssd, init_sequence, sizeof(init_sequence));
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+  ssd1306_flush_wait(ssd);
   ssd->port_buffer[1] = command;
   i2c_write_blocking(
     ssd->i2c_port,
@@ -52,68 +86,226 @@ void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
   );
 }
 
-void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
-    false
-  );
+// Envia uma sequência de comandos (com seus argumentos) em uma única transação,
+// usando o byte de controle 0x00 (Co = 0, D/C = 0): todos os bytes seguintes são comandos.
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, size_t len) {
+  uint8_t buffer[SSD1306_MAX_COMMAND_LIST + 1];
+  ssd1306_flush_wait(ssd);
+  buffer[0] = 0x00;
+  while (len > 0) {
+    size_t chunk = len < SSD1306_MAX_COMMAND_LIST ? len : SSD1306_MAX_COMMAND_LIST;
+    memcpy(buffer + 1, commands, chunk);
+    i2c_write_blocking(ssd->i2c_port, ssd->address, buffer, chunk + 1, false);
+    commands += chunk;
+    len -= chunk;
+  }
 }
 
-void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-  uint16_t index = (y >> 3) + (x << 3) + 1;
-  uint8_t pixel = (y & 0b111);
-  if (value)
-    ssd->ram_buffer[index] |= (1 << pixel);
-  else
-    ssd->ram_buffer[index] &= ~(1 << pixel);
+static void ssd1306_set_window(ssd1306_t *ssd, uint8_t col0, uint8_t col1, uint8_t page0, uint8_t page1) {
+  const uint8_t window[] = {SET_COL_ADDR, col0, col1, SET_PAGE_ADDR, page0, page1};
+  ssd1306_command_list(ssd, window, sizeof(window));
 }
 
-/*
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-  uint8_t byte = value ? 0xFF : 0x00;
-  for (uint8_t i = 1; i < ssd->bufsize; ++i)
-    ssd->ram_buffer[i] = byte;
-}*/
+// Decide o que transmitir: uma janela por página alterada, com as colunas aparadas
+// contra o conteúdo que o display já tem (shadow), ou o quadro inteiro quando isso
+// sai mais barato. Retorna o número de regiões; o quadro inteiro é a região única
+// que cobre todas as páginas.
+static uint8_t ssd1306_plan_flush(ssd1306_t *ssd, ssd1306_region_t *regions) {
+  size_t total = 0;
+  uint8_t count = 0;
 
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    // Itera por todas as posições do display
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
-        }
+  if (ssd->shadow_valid) {
+    for (uint8_t page = 0; page < ssd->pages; ++page) {
+      int c0 = ssd->dirty_min[page], c1 = ssd->dirty_max[page];
+      while (c0 <= c1 && ssd->ram_buffer[ssd1306_index(c0, page)] == ssd->shadow[ssd1306_index(c0, page) - 1])
+        ++c0;
+      while (c1 >= c0 && ssd->ram_buffer[ssd1306_index(c1, page)] == ssd->shadow[ssd1306_index(c1, page) - 1])
+        --c1;
+      if (c0 > c1)
+        continue;
+      regions[count++] = (ssd1306_region_t){c0, c1, page, page};
+      total += (c1 - c0 + 1) + SSD1306_WINDOW_COST;
     }
+    if (total < ssd->bufsize - 1)
+      return count;
+  }
+
+  regions[0] = (ssd1306_region_t){0, ssd->width - 1, 0, ssd->pages - 1};
+  return 1;
+}
+
+static inline bool ssd1306_region_is_full(ssd1306_t *ssd, const ssd1306_region_t *region) {
+  return region->page0 == 0 && region->page1 == ssd->pages - 1;
 }
 
+// O display passa a ter o conteúdo atual do ram_buffer
+static void ssd1306_commit_flush(ssd1306_t *ssd) {
+  memcpy(ssd->shadow, ssd->ram_buffer + 1, ssd->bufsize - 1);
+  ssd->shadow_valid = true;
+  ssd1306_clear_dirty(ssd);
+}
 
+// Envia apenas as regiões alteradas desde o último envio
+void ssd1306_send_data(ssd1306_t *ssd) {
+  ssd1306_region_t regions[SSD1306_MAX_PAGES];
+  uint8_t count = ssd1306_plan_flush(ssd, regions);
 
-void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
-  for (uint8_t x = left; x < left + width; ++x) {
-    ssd1306_pixel(ssd, x, top, value);
-    ssd1306_pixel(ssd, x, top + height - 1, value);
+  for (uint8_t i = 0; i < count; ++i) {
+    const ssd1306_region_t *region = &regions[i];
+    ssd1306_set_window(ssd, region->col0, region->col1, region->page0, region->page1);
+    if (ssd1306_region_is_full(ssd, region)) {
+      i2c_write_blocking(ssd->i2c_port, ssd->address, ssd->ram_buffer, ssd->bufsize, false);
+      continue;
+    }
+    uint8_t data[WIDTH + 1];
+    size_t len = 0;
+    data[len++] = 0x40;
+    for (uint8_t x = region->col0; x <= region->col1; ++x)
+      data[len++] = ssd->ram_buffer[ssd1306_index(x, region->page0)];
+    i2c_write_blocking(ssd->i2c_port, ssd->address, data, len, false);
+  }
+  ssd1306_commit_flush(ssd);
+}
+
+// Sinaliza o fim da alimentação do FIFO; os últimos bytes ainda podem estar no barramento
+static void ssd1306_dma_irq_handler(void) {
+  ssd1306_t *ssd = dma_owner;
+  if (!ssd || !dma_channel_get_irq0_status(ssd->dma_channel))
+    return;
+  dma_channel_acknowledge_irq0(ssd->dma_channel);
+  if (ssd->flush_callback)
+    ssd->flush_callback(ssd);
+}
+
+static bool ssd1306_dma_setup(ssd1306_t *ssd) {
+  int channel = dma_claim_unused_channel(false);
+  if (channel < 0)
+    return false;
+
+  ssd->dma_buffer = malloc(SSD1306_DMA_WORDS(ssd) * sizeof(uint16_t));
+  if (!ssd->dma_buffer) {
+    dma_channel_unclaim(channel);
+    return false;
   }
-  for (uint8_t y = top; y < top + height; ++y) {
-    ssd1306_pixel(ssd, left, y, value);
-    ssd1306_pixel(ssd, left + width - 1, y, value);
+  ssd->dma_channel = channel;
+
+  // Cada palavra de 16 bits vai para o data_cmd: byte de dado nos bits 7:0, STOP no bit 9
+  dma_channel_config config = dma_channel_get_default_config(channel);
+  channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+  channel_config_set_read_increment(&config, true);
+  channel_config_set_write_increment(&config, false);
+  channel_config_set_dreq(&config, i2c_get_dreq(ssd->i2c_port, true));
+  dma_channel_configure(channel, &config, &i2c_get_hw(ssd->i2c_port)->data_cmd, ssd->dma_buffer, 0, false);
+
+  dma_owner = ssd;
+  dma_channel_set_irq0_enabled(channel, true);
+  irq_add_shared_handler(DMA_IRQ_0, ssd1306_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+  irq_set_enabled(DMA_IRQ_0, true);
+  return true;
+}
+
+// Envia as regiões alteradas via DMA e retorna imediatamente. Os dados são copiados
+// antes do envio, então o próximo quadro já pode ser desenhado enquanto este é transmitido.
+// Sem canal DMA livre, recai no envio bloqueante.
+void ssd1306_send_data_async(ssd1306_t *ssd) {
+  if (ssd->dma_channel < 0 && !ssd1306_dma_setup(ssd)) {
+    ssd1306_send_data(ssd);
+    return;
   }
 
-  if (fill) {
-    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
-        ssd1306_pixel(ssd, x, y, value);
-      }
+  ssd1306_flush_wait(ssd); // O buffer do DMA ainda pode estar em uso pelo envio anterior
+
+  ssd1306_region_t regions[SSD1306_MAX_PAGES];
+  uint8_t count = ssd1306_plan_flush(ssd, regions);
+  size_t n = 0;
+
+  // Uma sequência de transações separadas pelo bit STOP: janela de cada região e seus dados
+  for (uint8_t i = 0; i < count; ++i) {
+    const ssd1306_region_t *region = &regions[i];
+    const uint8_t window[] = {0x00, SET_COL_ADDR, region->col0, region->col1, SET_PAGE_ADDR, region->page0, region->page1};
+    for (uint8_t c = 0; c < sizeof(window); ++c)
+      ssd->dma_buffer[n++] = window[c];
+    ssd->dma_buffer[n - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+    if (ssd1306_region_is_full(ssd, region)) {
+      for (size_t j = 0; j < ssd->bufsize; ++j)
+        ssd->dma_buffer[n++] = ssd->ram_buffer[j];
+    } else {
+      ssd->dma_buffer[n++] = 0x40;
+      for (uint8_t x = region->col0; x <= region->col1; ++x)
+        ssd->dma_buffer[n++] = ssd->ram_buffer[ssd1306_index(x, region->page0)];
     }
+    ssd->dma_buffer[n - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+  }
+  ssd1306_commit_flush(ssd);
+  if (n == 0)
+    return;
+
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  hw->enable = 0;
+  hw->tar = ssd->address;
+  hw->enable = 1;
+  dma_channel_transfer_from_buffer_now(ssd->dma_channel, ssd->dma_buffer, n);
+}
+
+// Verdadeiro enquanto houver quadro sendo transmitido (DMA ativo ou bytes no barramento)
+bool ssd1306_flush_busy(ssd1306_t *ssd) {
+  if (ssd->dma_channel < 0)
+    return false;
+  return dma_channel_is_busy(ssd->dma_channel) ||
+         (i2c_get_hw(ssd->i2c_port)->status & I2C_IC_STATUS_ACTIVITY_BITS);
+}
+
+void ssd1306_flush_wait(ssd1306_t *ssd) {
+  while (ssd1306_flush_busy(ssd))
+    tight_loop_contents();
+}
+
+void ssd1306_set_flush_callback(ssd1306_t *ssd, ssd1306_flush_callback_t callback) {
+  ssd->flush_callback = callback;
+}
+
+// Substitui os bits de `mask` no byte (coluna, página) pelos de `bits`, marcando a região se mudar
+static inline void ssd1306_merge(ssd1306_t *ssd, uint8_t x, uint8_t page, uint8_t mask, uint8_t bits) {
+  uint16_t index = ssd1306_index(x, page);
+  uint8_t old = ssd->ram_buffer[index];
+  uint8_t byte = (old & ~mask) | (bits & mask);
+  if (byte != old) {
+    ssd->ram_buffer[index] = byte;
+    ssd1306_mark_dirty(ssd, x, page);
   }
 }
 
+void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
+  if (x >= ssd->width || y >= ssd->height)
+    return;
+  uint8_t pixel = (y & 0b111);
+  ssd1306_merge(ssd, x, y >> 3, 1 << pixel, value ? 0xFF : 0x00);
+}
+
+void ssd1306_fill(ssd1306_t *ssd, bool value) {
+  memset(ssd->ram_buffer + 1, value ? 0xFF : 0x00, ssd->bufsize - 1);
+  // O envio apara as colunas que não mudaram, então basta marcar tudo
+  memset(ssd->dirty_min, 0, sizeof(ssd->dirty_min));
+  memset(ssd->dirty_max, ssd->width - 1, sizeof(ssd->dirty_max));
+}
+
+void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+  if (width == 0 || height == 0)
+    return;
+  uint8_t right = left + width - 1;
+  uint8_t bottom = top + height - 1;
+
+  if (fill) {
+    for (uint8_t x = left; x <= right; ++x)
+      ssd1306_vline(ssd, x, top, bottom, value);
+    return;
+  }
+  ssd1306_hline(ssd, left, right, top, value);
+  ssd1306_hline(ssd, left, right, bottom, value);
+  ssd1306_vline(ssd, left, top, bottom, value);
+  ssd1306_vline(ssd, right, top, bottom, value);
+}
+
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
     int dx = abs(x1 - x0);
     int dy = abs(y1 - y0);
@@ -143,14 +335,37 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 }
 
 
+// Linha horizontal: a mesma máscara de bit em cada coluna da página
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-  for (uint8_t x = x0; x <= x1; ++x)
-    ssd1306_pixel(ssd, x, y, value);
+  if (y >= ssd->height)
+    return;
+  if (x1 >= ssd->width)
+    x1 = ssd->width - 1;
+  uint8_t mask = 1 << (y & 0b111);
+  uint8_t bits = value ? 0xFF : 0x00;
+  for (uint16_t x = x0; x <= x1; ++x)
+    ssd1306_merge(ssd, x, y >> 3, mask, bits);
 }
 
+// Linha vertical: máscara parcial nas páginas das pontas e bytes inteiros no meio
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-  for (uint8_t y = y0; y <= y1; ++y)
-    ssd1306_pixel(ssd, x, y, value);
+  if (x >= ssd->width || y0 > y1 || y0 >= ssd->height)
+    return;
+  if (y1 >= ssd->height)
+    y1 = ssd->height - 1;
+  uint8_t bits = value ? 0xFF : 0x00;
+  uint8_t first = y0 >> 3, last = y1 >> 3;
+  uint8_t head = 0xFF << (y0 & 0b111);
+  uint8_t tail = 0xFF >> (7 - (y1 & 0b111));
+
+  if (first == last) {
+    ssd1306_merge(ssd, x, first, head & tail, bits);
+    return;
+  }
+  ssd1306_merge(ssd, x, first, head, bits);
+  for (uint8_t page = first + 1; page < last; ++page)
+    ssd1306_merge(ssd, x, page, 0xFF, bits);
+  ssd1306_merge(ssd, x, last, tail, bits);
 }
 
 // Função para desenhar um caractere
@@ -169,13 +384,25 @@ void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
     index = 0; // Índice 0 corresponde ao caractere "nada" (espaço)
   }
 
-  // Desenha o caractere na tela
-  for (uint8_t i = 0; i < 8; ++i)
+  // Cada byte da fonte é uma coluna do caractere, no mesmo formato das páginas do ram_buffer
+  uint8_t page = y >> 3;
+  uint8_t shift = y & 0b111;
+  if (y >= ssd->height)
+    return;
+
+  for (uint8_t i = 0; i < 8 && x + i < ssd->width; ++i)
   {
-    uint8_t line = font[index + i]; // Acessa a linha correspondente do caractere na fonte
-    for (uint8_t j = 0; j < 8; ++j)
+    uint8_t line = font[index + i];
+    if (shift == 0)
+    {
+      ssd1306_merge(ssd, x + i, page, 0xFF, line); // Alinhado à página: cópia direta do byte
+    }
+    else
     {
-      ssd1306_pixel(ssd, x + i, y + j, line & (1 << j)); // Desenha cada pixel do caractere
+      // Desalinhado: a coluna se divide entre duas páginas
+      ssd1306_merge(ssd, x + i, page, 0xFF << shift, line << shift);
+      if (page + 1 < ssd->pages)
+        ssd1306_merge(ssd, x + i, page + 1, 0xFF >> (8 - shift), line >> (8 - shift));
     }
   }
 }
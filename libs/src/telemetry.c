@@ -0,0 +1,179 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+#include "telemetry.h"
+
+static uint8_t* put_u16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static uint8_t* put_u32(uint8_t* p, uint32_t v) {
+    p = put_u16(p, (uint16_t)v);
+    return put_u16(p, (uint16_t)(v >> 16));
+}
+
+static uint16_t get_u16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t* p) {
+    return get_u16(p) | ((uint32_t)get_u16(p + 2) << 16);
+}
+
+/**
+ * @brief CRC-16/CCITT-FALSE (polinômio 0x1021, valor inicial 0xFFFF), bit a bit:
+ * os registros são curtos e isso evita uma tabela de 512 bytes.
+ * @param data Dados.
+ * @param len Tamanho em bytes.
+ * @return CRC.
+ */
+uint16_t telemetry_crc16(const uint8_t* data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)(data[i] << 8);
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief Codifica em COBS: cada bloco começa com a distância até o próximo zero (ou 0xFF
+ * para 254 bytes sem zero), de modo que a saída não contém 0x00.
+ * @param in Dados.
+ * @param len Tamanho dos dados.
+ * @param out Saída, com pelo menos COBS_MAX_ENCODED_LEN(len) bytes.
+ * @return Tamanho codificado, sem delimitador.
+ */
+size_t cobs_encode(const uint8_t* in, size_t len, uint8_t* out) {
+    size_t code_pos = 0, out_pos = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < len; i++) {
+        if (in[i] != 0) {
+            out[out_pos++] = in[i];
+            code++;
+        }
+        if (in[i] == 0 || code == 0xFF) {
+            out[code_pos] = code;
+            code_pos = out_pos++;
+            code = 1;
+        }
+    }
+    out[code_pos] = code;
+    return out_pos;
+}
+
+/**
+ * @brief Decodifica um bloco COBS (sem o delimitador).
+ * @param in Dados codificados.
+ * @param len Tamanho codificado.
+ * @param out Saída.
+ * @param out_max Capacidade da saída.
+ * @return Tamanho decodificado, ou 0 se houver um zero, um bloco truncado ou a saída estourar.
+ */
+size_t cobs_decode(const uint8_t* in, size_t len, uint8_t* out, size_t out_max) {
+    size_t in_pos = 0, out_pos = 0;
+
+    while (in_pos < len) {
+        uint8_t code = in[in_pos++];
+        if (code == 0 || in_pos + code - 1 > len) return 0;
+        for (uint8_t i = 1; i < code; i++) {
+            if (in[in_pos] == 0 || out_pos == out_max) return 0;
+            out[out_pos++] = in[in_pos++];
+        }
+        // Bloco curto implica um zero nos dados, exceto no último bloco
+        if (code != 0xFF && in_pos < len) {
+            if (out_pos == out_max) return 0;
+            out[out_pos++] = 0;
+        }
+    }
+    return out_pos;
+}
+
+/**
+ * @brief Serializa a amostra no layout de telemetry.h, acrescenta o CRC e codifica o quadro.
+ * @param sample Amostra.
+ * @param frame Saída com TELEMETRY_FRAME_MAX bytes.
+ * @return Tamanho do quadro, incluindo o 0x00 final.
+ */
+size_t telemetry_encode(const sample_record_t* sample, uint8_t* frame) {
+    uint8_t record[TELEMETRY_RECORD_LEN + TELEMETRY_CRC_LEN];
+    uint8_t* p = record;
+
+    *p++ = TELEMETRY_VERSION;
+    p = put_u32(p, sample->timestamp_ms);
+    p = put_u16(p, sample->raw_c);
+    p = put_u16(p, sample->raw_r);
+    p = put_u16(p, sample->raw_g);
+    p = put_u16(p, sample->raw_b);
+    p = put_u16(p, sample->lux);
+    p = put_u16(p, sample->hsv.h);
+    p = put_u16(p, sample->hsv.s);
+    *p++ = sample->hsv.v;
+    *p++ = (uint8_t)sample->cor;
+    *p++ = (uint8_t)sample->mode;
+    *p++ = sample->alert ? TELEMETRY_FLAG_ALERT : 0;
+    for (int i = 0; i < AMBIENT_OUTPUT_LEN; i++) {
+        p = put_u16(p, (uint16_t)sample->mlp_outputs[i]);
+    }
+    put_u16(p, telemetry_crc16(record, TELEMETRY_RECORD_LEN));
+
+    size_t len = cobs_encode(record, sizeof(record), frame);
+    frame[len++] = 0;
+    return len;
+}
+
+/**
+ * @brief Decodifica um quadro de telemetry_encode.
+ * @param frame Quadro sem o 0x00 final.
+ * @param len Tamanho do quadro.
+ * @param sample Amostra decodificada.
+ * @return false se o quadro for inválido.
+ */
+bool telemetry_decode(const uint8_t* frame, size_t len, sample_record_t* sample) {
+    uint8_t record[TELEMETRY_RECORD_LEN + TELEMETRY_CRC_LEN];
+
+    if (cobs_decode(frame, len, record, sizeof(record)) != sizeof(record)) return false;
+    if (get_u16(record + TELEMETRY_RECORD_LEN) != telemetry_crc16(record, TELEMETRY_RECORD_LEN)) return false;
+    if (record[0] != TELEMETRY_VERSION) return false;
+
+    memset(sample, 0, sizeof(*sample));
+    sample->timestamp_ms = get_u32(record + 1);
+    sample->raw_c = get_u16(record + 5);
+    sample->raw_r = get_u16(record + 7);
+    sample->raw_g = get_u16(record + 9);
+    sample->raw_b = get_u16(record + 11);
+    sample->lux = get_u16(record + 13);
+    sample->hsv.h = get_u16(record + 15);
+    sample->hsv.s = get_u16(record + 17);
+    sample->hsv.v = record[19];
+    sample->cor = (CorIdentificada)record[20];
+    sample->mode = (int8_t)record[21];
+    sample->alert = record[22] & TELEMETRY_FLAG_ALERT;
+    for (int i = 0; i < AMBIENT_OUTPUT_LEN; i++) {
+        sample->mlp_outputs[i] = (int16_t)get_u16(record + 23 + 2 * i);
+    }
+    return true;
+}
+
+/**
+ * @brief Envia a amostra como quadro binário na USB CDC. Sem host conectado o quadro é
+ * descartado na hora; conectado, o stdio do SDK limita a espera pelo buffer ao seu timeout.
+ * putchar_raw evita a tradução de \n para \r\n, que corromperia o quadro.
+ * @param sample Amostra.
+ * @return false se o quadro foi descartado.
+ */
+bool telemetry_send(const sample_record_t* sample) {
+    uint8_t frame[TELEMETRY_FRAME_MAX];
+
+    if (!stdio_usb_connected()) return false;
+    size_t len = telemetry_encode(sample, frame);
+    for (size_t i = 0; i < len; i++) {
+        putchar_raw(frame[i]);
+    }
+    return true;
+}
@@ -0,0 +1,98 @@
+#include <stdbool.h>
+#include "text_format.h"
+
+/**
+ * @brief Copia uma string.
+ * @param out Destino.
+ * @param s String terminada em '\0'.
+ * @return Ponteiro para o '\0' escrito.
+ */
+char* fmt_str(char* out, const char* s) {
+    while (*s) *out++ = *s++;
+    *out = '\0';
+    return out;
+}
+
+// Dígitos de value, com sinal opcional, alinhados à direita em width caracteres
+static char* fmt_digits(char* out, uint32_t value, bool negative, uint8_t width) {
+    char digits[10];
+    uint8_t n = 0;
+
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+
+    for (uint8_t len = n + negative; len < width; len++) *out++ = ' ';
+    if (negative) *out++ = '-';
+    while (n) *out++ = digits[--n];
+    *out = '\0';
+    return out;
+}
+
+/**
+ * @brief Escreve um inteiro sem sinal em decimal.
+ * @param out Destino.
+ * @param value Valor.
+ * @param width Largura mínima; completada com espaços à esquerda.
+ * @return Ponteiro para o '\0' escrito.
+ */
+char* fmt_uint(char* out, uint32_t value, uint8_t width) {
+    return fmt_digits(out, value, false, width);
+}
+
+/**
+ * @brief Escreve um inteiro com sinal em decimal.
+ * @param out Destino.
+ * @param value Valor.
+ * @param width Largura mínima, contando o sinal; completada com espaços à esquerda.
+ * @return Ponteiro para o '\0' escrito.
+ */
+char* fmt_int(char* out, int32_t value, uint8_t width) {
+    uint32_t magnitude = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+    return fmt_digits(out, magnitude, value < 0, width);
+}
+
+/**
+ * @brief Escreve a fração num / den em decimal, com um número fixo de casas. Serve para
+ * valores em ponto fixo (den = 2^bits, como Q15) ou em escalas arbitrárias (den = 255).
+ * O resultado é o mesmo do printf("%.*f") sobre o valor exato: arredonda para o mais
+ * próximo e, no empate, para o último dígito par.
+ * @param out Destino.
+ * @param num Numerador.
+ * @param den Denominador (> 0).
+ * @param decimals Casas decimais (até 9).
+ * @return Ponteiro para o '\0' escrito.
+ */
+char* fmt_decimal(char* out, int32_t num, uint32_t den, uint8_t decimals) {
+    uint32_t magnitude = num < 0 ? 0u - (uint32_t)num : (uint32_t)num;
+    uint64_t scale = 1;
+    for (uint8_t i = 0; i < decimals; i++) scale *= 10;
+
+    // Valor em unidades da última casa: q = magnitude * 10^decimals / den, arredondado
+    // Divisão de 32 bits quando cabe: a de 64 bits é uma rotina de software no Cortex-M0+
+    uint64_t scaled = (uint64_t)magnitude * scale;
+    uint64_t q, rem;
+    if (scaled >> 32) {
+        q = scaled / den;
+        rem = scaled % den;
+    } else {
+        q = (uint32_t)scaled / den;
+        rem = (uint32_t)scaled % den;
+    }
+    if (2 * rem > den || (2 * rem == den && (q & 1))) q++;
+
+    uint32_t integer = (uint32_t)(q / scale);
+    uint64_t frac = q % scale;
+    out = fmt_digits(out, integer, num < 0, 0); // Como o printf, mantém o sinal em "-0.00"
+    if (decimals) {
+        *out++ = '.';
+        for (uint8_t i = decimals; i > 0; i--) {
+            out[i - 1] = (char)('0' + frac % 10);
+            frac /= 10;
+        }
+        out += decimals;
+        *out = '\0';
+    }
+    return out;
+}
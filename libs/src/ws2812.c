@@ -0,0 +1,152 @@
+#include "ws2812.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+#include "pico/critical_section.h"
+#include "ws2812.pio.h"
+
+#define WS2812_FREQ 800000
+#define WS2812_WORD_US 30  // 24 bits a 800 kHz
+#define WS2812_RESET_US 60 // Linha em nível baixo que faz os LEDs travarem o quadro (mínimo 50 us)
+
+// Variáveis para o controle da máquina PIO
+static PIO np_pio;
+static uint np_sm;
+static int np_dma_channel;
+
+// O alarme troca os buffers no núcleo 0 enquanto o núcleo 1 desenha: os ponteiros e o estado
+// abaixo só são lidos ou alterados com np_lock
+static critical_section_t np_lock;
+
+// Framebuffers no formato da FIFO da PIO (GRB alinhado à esquerda), em ordem da cadeia de LEDs
+static uint32_t np_buffers[2][LEDS_COUNT];
+static uint32_t *np_front = np_buffers[0];
+static uint32_t *np_back = np_buffers[1];
+
+// Instante a partir do qual o quadro anterior terminou de sair (incluindo o reset)
+static absolute_time_t np_ready_at;
+static bool np_pending = false;
+static bool np_alarm_armed = false;
+
+// Troca os buffers e dispara o DMA do novo buffer da frente (com np_lock)
+static void np_start_frame() {
+    uint32_t *front = np_back;
+    np_back = np_front;
+    np_front = front;
+    for (int i = 0; i < LEDS_COUNT; i++) {
+        np_back[i] = np_front[i]; // O buffer de trás continua a partir do quadro exibido
+    }
+
+    np_ready_at = delayed_by_us(get_absolute_time(), LEDS_COUNT * WS2812_WORD_US + WS2812_RESET_US);
+    np_pending = false;
+    dma_channel_transfer_from_buffer_now(np_dma_channel, np_front, LEDS_COUNT);
+}
+
+static int64_t np_alarm_callback(alarm_id_t id, void *user_data) {
+    (void)id;
+    (void)user_data;
+
+    critical_section_enter_blocking(&np_lock);
+    np_alarm_armed = false;
+    if (np_pending) {
+        np_start_frame();
+    }
+    critical_section_exit(&np_lock);
+    return 0;
+}
+
+// Inicializa a máquina PIO e o canal DMA que a alimenta
+void np_init(uint pin){
+    critical_section_init(&np_lock);
+
+    // Aloca uma máquina PIO
+    np_pio = pio0;
+    int sm = pio_claim_unused_sm(np_pio, false);
+    if(sm < 0){
+        np_pio = pio1;
+        sm = pio_claim_unused_sm(np_pio, true); // Se não houver máquinas disponíveis, panic
+    }
+    np_sm = sm;
+
+    // Inicializa a máquina PIO com o programa ws2812_program
+    uint offset = pio_add_program(np_pio, &ws2812_program);
+    ws2812_program_init(np_pio, np_sm, offset, pin, WS2812_FREQ, false);
+
+    // Uma palavra de 32 bits por LED, no ritmo do DREQ da FIFO TX
+    np_dma_channel = dma_claim_unused_channel(true);
+    dma_channel_config config = dma_channel_get_default_config(np_dma_channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, pio_get_dreq(np_pio, np_sm, true));
+    dma_channel_configure(np_dma_channel, &config, &np_pio->txf[np_sm], np_front, LEDS_COUNT, false);
+
+    np_ready_at = get_absolute_time();
+}
+
+// Define a cor de um LED no buffer de trás (índice na ordem da cadeia)
+void np_set_pixel(uint index, uint8_t r, uint8_t g, uint8_t b) {
+    if (index < LEDS_COUNT) {
+        critical_section_enter_blocking(&np_lock);
+        np_back[index] = rgb_u32(r, g, b) << 8u;
+        critical_section_exit(&np_lock);
+    }
+}
+
+void np_fill(uint8_t r, uint8_t g, uint8_t b) {
+    uint32_t color = rgb_u32(r, g, b) << 8u;
+    critical_section_enter_blocking(&np_lock);
+    for (int i = 0; i < LEDS_COUNT; i++) {
+        np_back[i] = color;
+    }
+    critical_section_exit(&np_lock);
+}
+
+// Exibe o buffer de trás. Se o quadro anterior ainda estiver saindo, a troca fica
+// pendente e é feita por um alarme assim que a linha estiver livre.
+// Retorna true se o quadro começou a ser enviado imediatamente.
+bool np_show() {
+    bool started = false;
+
+    critical_section_enter_blocking(&np_lock);
+    if (absolute_time_diff_us(get_absolute_time(), np_ready_at) <= 0) {
+        np_start_frame();
+        started = true;
+    } else {
+        np_pending = true;
+        if (!np_alarm_armed) {
+            // Sem fire_if_past: o callback nunca roda aqui dentro, com np_lock já tomado.
+            // 0 = a linha liberou entre o teste e o alarme; -1 = sem alarmes livres, e o
+            // quadro pendente sai no próximo np_show()
+            alarm_id_t alarm = add_alarm_at(np_ready_at, np_alarm_callback, NULL, false);
+            if (alarm > 0) {
+                np_alarm_armed = true;
+            } else if (alarm == 0) {
+                np_start_frame();
+                started = true;
+            }
+        }
+    }
+    critical_section_exit(&np_lock);
+    return started;
+}
+
+// Define a cor dos LEDs da matriz
+void np_set_leds(const bool *matriz, uint8_t r, uint8_t g, uint8_t b)
+{
+    // Define a cor com base nos parâmetros fornecidos
+    uint32_t color = rgb_u32(r, g, b) << 8u;
+
+    // O primeiro LED da cadeia corresponde à última posição da máscara
+    critical_section_enter_blocking(&np_lock);
+    for (int i = 0; i < LEDS_COUNT; i++)
+    {
+        np_back[i] = matriz[24 - i] ? color : 0;
+    }
+    critical_section_exit(&np_lock);
+    np_show();
+}
+
+void np_clear(){
+    np_fill(0, 0, 0); // Desliga todos os LEDs
+    np_show();
+}
@@ -4,71 +4,108 @@
 #include "hardware/i2c.h"
 #include "hardware/gpio.h"
 #include "hardware/pwm.h"
+#include "hardware/sync.h"
+#include "pico/multicore.h"
+#include "pico/flash.h"
 
 // Inclusão das bibliotecas dos periféricos
 #include "bh1750.h"
 #include "ssd1306.h"
 #include "ws2812.h"
 #include "gy33.h"
+#include "buzzer.h"
 #include "mlp.h"
+#include "ambient_model.h"
 
 #include "config.h"
 #include "color_utils.h"
+#include "sample_ring.h"
+#include "scheduler.h"
+#include "sensor_history.h"
+#include "telemetry.h"
+#include "text_format.h"
+#include "profile.h"
+#include "ambient_classifier.h"
+#include "flash_log.h"
+#include "runtime_config.h"
 
 // --- Variáveis Globais de Estado ---
 volatile int led_state = 0;
 volatile uint32_t last_press_time = 0;
 volatile bool led_enabled = false;
+volatile bool screen = true;
 
 
 // --- Variáveis Globais ---
 ssd1306_t disp;
-uint buzzer_slice_num;
-bool screen = true;
+bh1750_t light_sensor;
+sample_ring_t samples; // Núcleo 0 -> núcleo 1
+sensor_history_t history; // Últimas leituras brutas (núcleo 0), base dos filtros
 
 // --- Definições das Funções ---
 
-void init_buzzer();
-void play_alert_tone();
+void core1_main();
 void init_leds_buttons();
 void gpio_irq_handler(uint gpio, uint32_t events);
 void switch_led_color();
 void init_i2c();
-void trained_mlp_model(); 
-int get_ambient_mode(); 
-
-// -- Multilayer Perceptron
-MLP mlp;
-#define INPUT_LAYER_LEN 3
-#define HIDDEN_LAYER_LEN 5
-#define OUTPUT_LAYER_LEN 3
-
-// Cores e luminosidade
-uint8_t r_norm = 0.0;
-uint8_t g_norm = 0.0;
-uint8_t b_norm = 0.0;
+void console_poll();
+
+// Última luminosidade lida do BH1750
 uint16_t lux = 0.0;
 
 
+// --- Tarefas ---
+// Cada núcleo roda sua tabela no escalonador por prazos (scheduler.h) e dorme em __wfe
+// entre os prazos. Núcleo 0: sensores, no ritmo de conversão de cada um. Núcleo 1: saídas.
+void task_read_light();
+void task_read_color();
+void task_update_leds();
+void task_update_display();
+void task_log();
+
+task_t sensor_tasks[] = {
+    {.name = "luz", .period_us = BH1750_HRES_MEAS_TIME_MS * 1000, .run = task_read_light},
+    {.name = "cor", .period_us = 0, .run = task_read_color}, // Período = tempo de integração do GY-33, que acompanha a exposição automática
+};
+#define SENSOR_TASKS_COUNT (sizeof(sensor_tasks) / sizeof(sensor_tasks[0]))
+
+task_t output_tasks[] = {
+    {.name = "leds", .period_us = 50 * 1000, .run = task_update_leds},
+    {.name = "display", .period_us = 100 * 1000, .run = task_update_display},
+    {.name = "log", .period_us = 1000 * 1000, .run = task_log},
+};
+#define OUTPUT_TASKS_COUNT (sizeof(output_tasks) / sizeof(output_tasks[0]))
+
+// Alerta: dois bipes curtos
+static const tone_step_t alert_tone_steps[] = {{128, 80}, {0, 80}, {128, 80}};
+static const tone_pattern_t alert_tone = {alert_tone_steps, sizeof(alert_tone_steps) / sizeof(alert_tone_steps[0])};
+
+// Estado do núcleo 1: última amostra recebida e alerta ainda não tocado
+sample_record_t latest_sample;
+bool have_sample = false;
+bool pending_alert = false;
+
+
 // --- Função Principal ---
+// Núcleo 0: produtor. Lê os sensores, calcula HSV, alertas e o modo do ambiente e
+// publica a amostra na fila; a saída (display, LEDs, buzzer, log) fica no núcleo 1.
 int main() {
     stdio_init_all();
     sleep_ms(1000);
 
-    // Inicialização de todos os periféricos e interfaces
-
-    np_init(WS2812_PIN);
-    np_clear();
-    init_buzzer();
+    // Inicialização dos sensores e entradas; os periféricos de saída são do núcleo 1
     init_leds_buttons();
     init_i2c();
     gy33_init();
     bh1750_power_on(I2C_PORT_SENSORS);
+    bh1750_start_continuous(&light_sensor, I2C_PORT_SENSORS);
 
-    ssd1306_init(&disp, 128, 64, false, ADDRESS_DISPLAY, I2C_PORT_DISPLAY);
-    ssd1306_config(&disp);
-    ssd1306_draw_string(&disp, "Iniciando...", 0, 0);
-    ssd1306_send_data(&disp);
+    runtime_config_load(); // Calibração e limiares gravados na flash (ou os padrões de config.h)
+    sample_ring_init(&samples);
+    sensor_history_init(&history, AMBIENT_HISTORY_EWMA_SHIFT);
+    flash_safe_execute_core_init(); // O núcleo 1 grava o log na flash e pausa este núcleo enquanto isso
+    multicore_launch_core1(core1_main);
     
     sleep_ms(1000);
     
@@ -76,104 +113,211 @@ int main() {
     gpio_set_irq_enabled_with_callback(BUTTON_A, GPIO_IRQ_EDGE_FALL, true, &gpio_irq_handler);
     gpio_set_irq_enabled_with_callback(BUTTON_B, GPIO_IRQ_EDGE_FALL, true, &gpio_irq_handler);
     gpio_set_irq_enabled_with_callback(BTN_JOYSTICK, GPIO_IRQ_EDGE_FALL, true, &gpio_irq_handler);
-    
-    bool matriz[LEDS_COUNT] = {0,0,0,0,0, 0,1,1,1,0, 0,1,1,1,0, 0,1,1,1,0, 0,0,0,0,0}; 
-    char oled_buffer[128];
-    uint16_t r, g, b, c;
-    int mode;
 
-    trained_mlp_model(); // Aplica o modelo treinado
+    sensor_tasks[1].period_us = gy33_integration_time_us();
+    scheduler_start(sensor_tasks, SENSOR_TASKS_COUNT);
+
+    while (1) {
+        scheduler_run_pending(sensor_tasks, SENSOR_TASKS_COUNT);
+        scheduler_idle(sensor_tasks, SENSOR_TASKS_COUNT);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Núcleo 1: consumidor. Recolhe as amostras da fila e roda as tarefas de saída;
+ * o __sev do produtor acorda o núcleo a cada amostra nova.
+ */
+void core1_main() {
+    np_init(WS2812_PIN);
+    np_clear();
+    buzzer_init(BUZZER_PIN);
+
+    ssd1306_init(&disp, 128, 64, false, ADDRESS_DISPLAY, I2C_PORT_DISPLAY);
+    ssd1306_config(&disp);
+    ssd1306_draw_string(&disp, "Iniciando...", 0, 0);
+    ssd1306_send_data(&disp);
 
+    flash_log_init();
+    scheduler_start(output_tasks, OUTPUT_TASKS_COUNT);
 
     while (1) {
-        // --- Leitura e Processamento ---
-        lux = bh1750_read_measurement(I2C_PORT_SENSORS);
-        gy33_read_color(&r, &g, &b, &c);
-        r_norm = map(r, 0, SENSOR_COLOR_MAX_VALUE, 0, 255);
-        g_norm = map(g, 0, SENSOR_COLOR_MAX_VALUE, 0, 255);
-        b_norm = map(b, 0, SENSOR_COLOR_MAX_VALUE, 0, 255);
-        printf("Lux: %u, R: %u, G: %u, B: %u\n", lux, r_norm, g_norm, b_norm);
-        float h, s, v;
-        RGBtoHSV(r_norm, g_norm, b_norm, &h, &s, &v);
-        CorIdentificada cor_atual = identificar_cor_hsv(h, s, v);
-
-        // --- Lógica de Alertas ---
-        bool low_light_alert = lux < LUMINOSITY_THRESHOLD; // Se a luminosidade está abaixo do limiar, alerta de baixa luminosidade
-        bool intense_red_alert = (cor_atual == VERMELHO && s > 0.6f && v > 0.7f); // Se a saturação e o valor são altos, indica vermelho intenso
-        if (low_light_alert || intense_red_alert) {
-            play_alert_tone();
+        sample_record_t sample;
+        while (sample_ring_pop(&samples, &sample)) {
+            latest_sample = sample;
+            have_sample = true;
+            if (TELEMETRY_BINARY) telemetry_send(&sample); // Todas as amostras, não só a última
+            flash_log_append(&sample);
+            pending_alert |= sample.alert;
         }
 
-        // --- Atualização da Matriz de LED ---
-        CorRGB cor_led_pura = obter_rgb_para_cor(cor_atual);
-        uint8_t brilho = map(lux, LUMINOSITY_THRESHOLD, LUMINOSITY_MAX, 1, 255); // Ajuste do brilho baseado na luminosidade
-        uint8_t r_final = (cor_led_pura.r * brilho) / 255;
-        uint8_t g_final = (cor_led_pura.g * brilho) / 255;
-        uint8_t b_final = (cor_led_pura.b * brilho) / 255;
+        if (!have_sample) {
+            __wfe(); // Nada para mostrar até a primeira amostra
+            continue;
+        }
+        scheduler_run_pending(output_tasks, OUTPUT_TASKS_COUNT);
+        scheduler_idle(output_tasks, OUTPUT_TASKS_COUNT);
+    }
+}
+
+/**
+ * @brief Tarefa do núcleo 0: lê a luminosidade quando o BH1750 tem conversão nova.
+ */
+void task_read_light() {
+    PROFILE_SCOPE(PROFILE_BH1750_READ) {
+        bh1750_try_read(&light_sensor, &lux); // Mantém o último valor enquanto não há conversão nova
+    }
+}
+
+/**
+ * @brief Tarefa do núcleo 0: lê a cor a cada ciclo de integração do GY-33, ajusta a
+ * exposição, classifica a amostra e a publica para o núcleo 1.
+ */
+void task_read_color() {
+    gy33_color_t color;
+    sample_record_t sample;
+    bool valid = false;
+
+    PROFILE_SCOPE(PROFILE_GY33_READ) {
+        valid = gy33_read_color_burst(&color);
+    }
+    if (!valid) return; // Erro no barramento ou integração com a exposição nova ainda em curso
+
+    // Normaliza com a exposição da leitura antes de o controle mudá-la. Com luz forte a
+    // integração encurta e a tarefa acompanha: mais amostras por segundo.
+    uint16_t clear = color.c;
+    gy33_normalize(&color);
+    bool changed = gy33_auto_exposure(clear);
+    sensor_tasks[1].period_us = gy33_integration_time_us() + (changed ? GY33_RESTART_US : 0);
+
+    uint16_t raw[SENSOR_CHANNELS] = {lux, color.r, color.g, color.b, color.c};
+    runtime_config_sync(); // Adota uma configuração nova vinda do console
+    classify_sample(&history, &runtime_config, to_ms_since_boot(get_absolute_time()), raw, &sample);
+
+    sample_ring_push(&samples, &sample); // Não bloqueia: com a fila cheia a amostra é descartada
+}
+
+/**
+ * @brief Tarefa do núcleo 1: matriz de LEDs, LED RGB e alerta sonoro.
+ */
+void task_update_leds() {
+    static const bool matriz[LEDS_COUNT] = {0,0,0,0,0, 0,1,1,1,0, 0,1,1,1,0, 0,1,1,1,0, 0,0,0,0,0};
+
+    // --- Atualização da Matriz de LED ---
+    CorRGB cor_led_pura = obter_rgb_para_cor(latest_sample.cor);
+    uint8_t brilho = map(latest_sample.lux, latest_sample.lux_min, latest_sample.lux_max, 1, 255); // Ajuste do brilho baseado na luminosidade
+    uint8_t r_final = (cor_led_pura.r * brilho) / 255;
+    uint8_t g_final = (cor_led_pura.g * brilho) / 255;
+    uint8_t b_final = (cor_led_pura.b * brilho) / 255;
+    PROFILE_SCOPE(PROFILE_LEDS) {
         np_set_leds(matriz, r_final, g_final, b_final);
+    }
 
-        mode = get_ambient_mode();
-        
-        // --- Exibição no Display OLED ---
+    // --- Controle do LED RGB ---
+    switch_led_color();
+
+    // --- Alerta sonoro (tocado em segundo plano pelo alarme do buzzer) ---
+    if (pending_alert) {
+        pending_alert = false;
+        if (!buzzer_busy()) buzzer_play(&alert_tone);
+    }
+}
+
+/**
+ * @brief Tarefa do núcleo 1: redesenha o display OLED com a última amostra (~10 Hz).
+ */
+void task_update_display() {
+    char oled_buffer[24];
+    const sample_record_t *sample = &latest_sample;
+
+    // Formatação inteira (text_format.h): o printf de float custa milhares de ciclos sem FPU
+    PROFILE_SCOPE(PROFILE_OLED_DRAW) {
         ssd1306_fill(&disp, false);
-        sprintf(oled_buffer, "Cor: %s", obter_nome_para_cor(cor_atual));
+        fmt_str(fmt_str(oled_buffer, "Cor: "), obter_nome_para_cor(sample->cor));
         ssd1306_draw_string(&disp, oled_buffer, 0, 0);
         if(screen) {
-            sprintf(oled_buffer, "H:%3.0f", h);
+            fmt_uint(fmt_str(oled_buffer, "H:"), (sample->hsv.h + (1 << (HSV_H_FRAC_BITS - 1))) >> HSV_H_FRAC_BITS, 3);
             ssd1306_draw_string(&disp, oled_buffer, 34, 16);
-            sprintf(oled_buffer, "S:%.2f", s);
+            fmt_decimal(fmt_str(oled_buffer, "S:"), sample->hsv.s, HSV_S_ONE, 2);
             ssd1306_draw_string(&disp, oled_buffer, 34, 26);
-            sprintf(oled_buffer, "V:%.2f", v);
+            fmt_decimal(fmt_str(oled_buffer, "V:"), sample->hsv.v, 255, 2);
             ssd1306_draw_string(&disp, oled_buffer, 34, 36);
         } else {
-            sprintf(oled_buffer, "R:%u", r_norm);
+            fmt_uint(fmt_str(oled_buffer, "R:"), sample->r, 0);
             ssd1306_draw_string(&disp, oled_buffer, 35, 16);
-            sprintf(oled_buffer, "G:%u", g_norm);
+            fmt_uint(fmt_str(oled_buffer, "G:"), sample->g, 0);
             ssd1306_draw_string(&disp, oled_buffer, 35, 26);
-            sprintf(oled_buffer, "B:%u", b_norm);
+            fmt_uint(fmt_str(oled_buffer, "B:"), sample->b, 0);
             ssd1306_draw_string(&disp, oled_buffer, 35, 36);
         }
-        sprintf(oled_buffer, "Lux:%u", lux);
+        fmt_uint(fmt_str(oled_buffer, "Lux:"), sample->lux, 0);
         ssd1306_draw_string(&disp, oled_buffer, 0, 52);
-        sprintf(oled_buffer, (mode==0)?"Idle":(mode==1)?"Work":(mode==2)?"Fest":"????");
-        ssd1306_draw_string(&disp, oled_buffer, 90, 52);
-        ssd1306_send_data(&disp);
-        
-        // --- Controle do LED RGB ---
-        switch_led_color();
-
-        printf("\n\nModo do ambiente: %i\n\n", get_ambient_mode());
-        sleep_ms(200);
+        ssd1306_draw_string(&disp, (sample->mode==0)?"Idle":(sample->mode==1)?"Work":(sample->mode==2)?"Fest":"????", 90, 52);
+    }
+    PROFILE_SCOPE(PROFILE_OLED_SEND) {
+        ssd1306_send_data_async(&disp); // Transmite por DMA enquanto o laço segue
     }
-
-    return 0;
 }
 
-
 /**
- * @brief Inicializa o pino do buzzer para operar com PWM.
+ * @brief Lê os comandos do stdio, sem bloquear. No início de uma linha, 'd' envia a
+ * configuração e o log da flash (host/tools/flash_log_replay), 'p' imprime o perfil e 'r'
+ * o zera; as demais linhas vão para runtime_config_command ("cfg ...").
  */
-void init_buzzer() {
-    gpio_set_function(BUZZER_PIN, GPIO_FUNC_PWM);
-    buzzer_slice_num = pwm_gpio_to_slice_num(BUZZER_PIN);
-    pwm_config config = pwm_get_default_config();
-    pwm_config_set_clkdiv(&config, 488.0f);
-    pwm_config_set_wrap(&config, 255);
-    pwm_init(buzzer_slice_num, &config, true);
-    pwm_set_gpio_level(BUZZER_PIN, 0);
+void console_poll() {
+    static char line[64];
+    static uint len = 0;
+    int c;
+
+    while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+        if (len == 0 && (c == 'd' || c == 'p' || c == 'r')) {
+            if (c == 'd') {
+                runtime_config_dump(putchar_raw);
+                flash_log_dump(putchar_raw);
+            }
+            if (c == 'p') profile_dump();
+            if (c == 'r') profile_reset();
+        } else if (c == '\n' || c == '\r') {
+            line[len] = '\0';
+            if (len) runtime_config_command(line);
+            len = 0;
+        } else if (len < sizeof(line) - 1) {
+            line[len++] = (char)c;
+        }
+    }
 }
 
 /**
- * @brief Toca um som de alerta curto (dois bipes) no buzzer.
+ * @brief Tarefa do núcleo 1: registra a última amostra e os contadores das tarefas na USB (1 Hz).
+ * Desligada no modo de telemetria binária, em que as amostras saem pelo laço do núcleo 1.
  */
-void play_alert_tone() {
-    pwm_set_gpio_level(BUZZER_PIN, 128);
-    sleep_ms(80);
-    pwm_set_gpio_level(BUZZER_PIN, 0);
-    sleep_ms(80);
-    pwm_set_gpio_level(BUZZER_PIN, 128);
-    sleep_ms(80);
-    pwm_set_gpio_level(BUZZER_PIN, 0);
+void task_log() {
+    const sample_record_t *sample = &latest_sample;
+
+    console_poll();
+
+    if (TELEMETRY_BINARY) return; // Texto no meio dos quadros binários só geraria quadros inválidos
+
+    printf("Lux: %u, R: %u, G: %u, B: %u\n", sample->lux, sample->r, sample->g, sample->b);
+    printf("\nMLP output: %.2f %.2f %.2f\n", sample->mlp_outputs[0] / (float)MLP_Q15_ONE,
+           sample->mlp_outputs[1] / (float)MLP_Q15_ONE, sample->mlp_outputs[2] / (float)MLP_Q15_ONE);
+    printf("\n\nModo do ambiente: %i\n\n", sample->mode);
+
+    printf("Tarefas (execucoes/atrasos):");
+    for (uint i = 0; i < SENSOR_TASKS_COUNT; i++) {
+        printf(" %s %lu/%lu", sensor_tasks[i].name, (unsigned long)sensor_tasks[i].runs, (unsigned long)sensor_tasks[i].overruns);
+    }
+    for (uint i = 0; i < OUTPUT_TASKS_COUNT; i++) {
+        printf(" %s %lu/%lu", output_tasks[i].name, (unsigned long)output_tasks[i].runs, (unsigned long)output_tasks[i].overruns);
+    }
+    printf(", descartadas %lu\n", (unsigned long)samples.dropped);
+
+    flash_log_stats_t log_stats = flash_log_stats();
+    if (log_stats.failed_writes) {
+        printf("Log da flash: %lu gravacoes falharam, %lu amostras perdidas\n", (unsigned long)log_stats.failed_writes,
+               (unsigned long)log_stats.dropped_samples);
+    }
 }
 
 
@@ -273,98 +417,3 @@ void switch_led_color() {
     }
 }
 
-int get_ambient_mode() {
-    float xMin[3] = {0.0, 0.0, 0.0};
-    float xMax[3] = {255.0, 255.0, 255.0};
-    float yMin[3] = {0.0, 0.0, 0.0};
-    float yMax[3] = {1.0, 1.0, 1.0};
-
-    float X[3] = {r_norm, g_norm, b_norm};
-
-    // Normalização
-    for (int j = 0; j < 3; j++) {
-        X[j] = (X[j] - xMin[j]) / (xMax[j] - xMin[j]);
-    }
-
-    // Forward MLP
-    forward(&mlp, X);
-
-    float *o = mlp.output_layer_outputs;
-    float threshold_one = 0.95f;
-    float threshold_zero = 0.05f;
-
-    // Desnormaliza saída
-    for (int k = 0; k < mlp.output_layer_length; k++) {
-        o[k] = o[k] * (yMax[k] - yMin[k]) + yMin[k];
-    }
-
-    printf("\nMLP output: %.2f %.2f %.2f\n", o[0], o[1], o[2]);
-
-    // Verifica saída “quase perfeita”
-    for (int i = 0; i < mlp.output_layer_length; i++) {
-        if (o[i] >= threshold_one) {
-            int others_are_zero = 1;
-            for (int j = 0; j < mlp.output_layer_length; j++) {
-                if (j != i && o[j] > threshold_zero) {
-                    others_are_zero = 0;
-                    break;
-                }
-            }
-
-            if (others_are_zero) {
-                // Verificação extra com Lux
-                if (i == 0 && (lux >= 10 && lux <= 300)) return 0; // Relax
-                if (i == 1 && (lux >= 300 && lux <= 700)) return 1; // Work
-                if (i == 2 && (lux >= 700 && lux <= 1000)) return 2; // Party
-
-                return 3; // Lux fora da faixa → Outlier
-            }
-        }
-    }
-
-    return 3; // Incerto
-}
-
-
-
-void trained_mlp_model() {
-    mlp.input_layer_length = INPUT_LAYER_LEN;
-    mlp.hidden_layer_length = HIDDEN_LAYER_LEN;
-    mlp.output_layer_length = OUTPUT_LAYER_LEN;
-
-    float hidden_layer_weights[HIDDEN_LAYER_LEN][INPUT_LAYER_LEN+1] = {
-        {2.661857, 6.408717, 1.197877, -5.405861, },
-        {-2.044108, -5.768311, -0.194693, 4.042969, },
-        {3.156306, -5.066918, -4.585429, 1.241510, },
-        {-12.349979, -2.461361, 3.371196, 4.594296, },
-        {4.260282, -4.847218, -4.883586, 0.496394, },
-    };
-
-    float output_layer_weights[OUTPUT_LAYER_LEN ][HIDDEN_LAYER_LEN+1] = {
-        {-5.191444, 1.899328, -2.282097, 12.606183, -3.801378, -3.360971, },
-        {8.362973, -6.287300, -4.975049, -11.016505, -4.422555, 2.839259, },
-        {-6.135138, 2.244717, 5.509221, -5.429541, 6.808523, -3.378476, },
-    };
-
-    // Alocar pesos da hidden layer
-    mlp.hidden_layer_weights = (float**) malloc(mlp.hidden_layer_length * sizeof(float*));
-    for (int i = 0; i < mlp.hidden_layer_length; i++) {
-        mlp.hidden_layer_weights[i] = (float*) malloc((mlp.input_layer_length + 1) * sizeof(float));
-        for (int j = 0; j < (mlp.input_layer_length + 1); j++) {
-            mlp.hidden_layer_weights[i][j] = hidden_layer_weights[i][j];
-        }
-    }
-
-    // Alocar pesos da output layer
-    mlp.output_layer_weights = (float**) malloc(mlp.output_layer_length * sizeof(float*));
-    for (int i = 0; i < mlp.output_layer_length; i++) {
-        mlp.output_layer_weights[i] = (float*) malloc((mlp.hidden_layer_length + 1) * sizeof(float));
-        for (int j = 0; j < (mlp.hidden_layer_length + 1); j++) {
-            mlp.output_layer_weights[i][j] = output_layer_weights[i][j];
-        }
-    }
-
-    // Alocar saídas
-    mlp.hidden_layer_outputs = (float*) malloc(mlp.hidden_layer_length * sizeof(float));
-    mlp.output_layer_outputs = (float*) malloc(mlp.output_layer_length * sizeof(float));
-}
\ No newline at end of file